@@ -0,0 +1,74 @@
+/*
+ * benchmark implementaci tabulky z ht_backend.h
+ *
+ * prelozi se zvlast pro kazdou implementaci (make bench to udela pro vsechny)
+ * a meri cas vlozeni, uspesneho a neuspesneho vyhledani a smazani
+ *
+ * ./bench_backend_swiss [pocet slov] [soubor se slovy]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "ht_backend.h"
+
+/* vychozi pocet slov, pevna ht_table_t ma jen MAX_HT_SIZE radku a s vic
+ * slovy by trvala minuty */
+#if HT_BACKEND == HT_BACKEND_CHAIN
+#define DEFAULT_COUNT 20000
+#else
+#define DEFAULT_COUNT 200000
+#endif
+
+int main(int argc, char *argv[]) {
+    size_t count = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : DEFAULT_COUNT;
+    bench_corpus_t corpus, misses;
+    bench_corpus_default(&corpus, argc > 2 ? argv[2] : NULL);
+    bench_corpus_synthetic(&misses, count, 2);
+    if (count == 0 || count > corpus.count) {
+        count = corpus.count;
+    }
+
+    htb_table_t *table = malloc(sizeof(htb_table_t));
+    if (table == NULL || !htb_init(table)) {
+        fprintf(stderr, "bench_backend: nedostatek pameti\n");
+        return 1;
+    }
+
+    double start = bench_now_ns();
+    for (size_t i = 0; i < count; i++) {
+        htb_insert(table, corpus.words[i], (float)i);
+    }
+    double insert_ns = bench_now_ns() - start;
+
+    size_t found = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < count; i++) {
+        found += htb_get(table, corpus.words[i]) != NULL;
+    }
+    double hit_ns = bench_now_ns() - start;
+
+    size_t missed = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < count; i++) {
+        missed += htb_get(table, misses.words[i]) == NULL;
+    }
+    double miss_ns = bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (size_t i = 0; i < count; i++) {
+        htb_delete(table, corpus.words[i]);
+    }
+    double delete_ns = bench_now_ns() - start;
+
+    printf("%-8s %zu slov | insert %7.1f ns | hit %7.1f ns | miss %7.1f ns "
+           "| delete %7.1f ns | nalezeno %zu, nenalezeno %zu\n",
+           HTB_NAME, count, insert_ns / count, hit_ns / count, miss_ns / count,
+           delete_ns / count, found, missed);
+
+    htb_destroy(table);
+    free(table);
+    bench_corpus_free(&corpus);
+    bench_corpus_free(&misses);
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * benchmark davkoveho vyhledani ht_map_get_batch proti smycce ht_map_get
+ *
+ * tabulka se naplni vsemi slovy (aby se nevesla do cache), pak se hleda
+ * promichany proud klicu, z nehoz ctvrtina v tabulce neni; davkove se
+ * hleda po DAVKA klicich, jak by to delal server obsluhujici pozadavky
+ *
+ * ./bench_batch [pocet slov] [soubor se slovy]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "ht_map.h"
+
+/* velikosti davek, ktere se zmeri */
+static const size_t BATCH_SIZES[] = {16, 256, 4096};
+
+int main(int argc, char *argv[]) {
+    size_t count = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 0;
+    bench_corpus_t corpus, misses;
+    bench_corpus_default(&corpus, argc > 2 ? argv[2] : NULL);
+    if (count == 0 || count > corpus.count) {
+        count = corpus.count;
+    }
+    bench_corpus_synthetic(&misses, count / 4 + 1, 2);
+
+    ht_map_t map;
+    size_t lookups = count + misses.count;
+    char **keys = malloc(lookups * sizeof(char *));
+    float **values = malloc(lookups * sizeof(float *));
+    if (keys == NULL || values == NULL || !ht_map_init(&map)) {
+        fprintf(stderr, "bench_batch: nedostatek pameti\n");
+        return 1;
+    }
+    for (size_t i = 0; i < count; i++) {
+        ht_map_insert(&map, corpus.words[i], (float)i);
+        keys[i] = corpus.words[i];
+    }
+    for (size_t i = 0; i < misses.count; i++) {
+        keys[count + i] = misses.words[i];
+    }
+    unsigned long long state = 88172645463325252ull;
+    for (size_t i = lookups - 1; i > 0; i--) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        size_t j = state % (i + 1);
+        char *tmp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = tmp;
+    }
+
+    size_t found = 0;
+    double start = bench_now_ns();
+    for (size_t i = 0; i < lookups; i++) {
+        found += ht_map_get(&map, keys[i]) != NULL;
+    }
+    double single_ns = bench_now_ns() - start;
+    printf("%zu slov v tabulce, %zu hledani\n", count, lookups);
+    printf("ht_map_get            | %6.1f ns/klic | nalezeno %zu\n",
+           single_ns / lookups, found);
+
+    for (size_t b = 0; b < sizeof(BATCH_SIZES) / sizeof(BATCH_SIZES[0]); b++) {
+        size_t batch = BATCH_SIZES[b];
+        start = bench_now_ns();
+        for (size_t i = 0; i < lookups; i += batch) {
+            size_t n = lookups - i < batch ? lookups - i : batch;
+            ht_map_get_batch(&map, keys + i, n, values + i);
+        }
+        double batch_ns = bench_now_ns() - start;
+        found = 0;
+        for (size_t i = 0; i < lookups; i++) {
+            found += values[i] != NULL;
+        }
+        printf("ht_map_get_batch %4zu | %6.1f ns/klic | nalezeno %zu | "
+               "zrychleni %.2fx\n",
+               batch, batch_ns / lookups, found, single_ns / batch_ns);
+    }
+
+    ht_map_destroy(&map);
+    free(values);
+    free(keys);
+    bench_corpus_free(&corpus);
+    bench_corpus_free(&misses);
+    return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * benchmark Bloomova filtru pred seznamy synonym ht_map_t
+ *
+ * do tabulky se vlozi prvni polovina slov, druha polovina slouzi jako
+ * chybejici klice; meri se neuspesne i uspesne hledani bez filtru a s nim
+ * a podil falesne pozitivnich odpovedi filtru
+ *
+ * ./bench_bloom [pocet slov] [soubor se slovy]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "ht_map.h"
+
+/* kolikrat se kazde hledani zopakuje, at cas neni moc kratky */
+#define ROUNDS 3
+
+/* prumerny cas hledani klicu words[from..to) v ns, do *found pocet nalezenych */
+double time_lookups(ht_map_t *map, char **words, size_t from, size_t to,
+                    size_t *found) {
+    *found = 0;
+    double start = bench_now_ns();
+    for (unsigned int r = 0; r < ROUNDS; r++) {
+        for (size_t i = from; i < to; i++) {
+            *found += ht_map_get(map, words[i]) != NULL;
+        }
+    }
+    *found /= ROUNDS;
+    return (bench_now_ns() - start) / ROUNDS / (double)(to - from);
+}
+
+int main(int argc, char *argv[]) {
+    size_t count = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 0;
+    bench_corpus_t corpus;
+    bench_corpus_default(&corpus, argc > 2 ? argv[2] : NULL);
+    if (count == 0 || count > corpus.count) {
+        count = corpus.count;
+    }
+    size_t half = count / 2;
+
+    ht_map_t map;
+    if (!ht_map_init(&map)) {
+        fprintf(stderr, "bench_bloom: nedostatek pameti\n");
+        return 1;
+    }
+    for (size_t i = 0; i < half; i++) {
+        ht_map_insert(&map, corpus.words[i], (float)i);
+    }
+
+    size_t hits, false_hits;
+    double hit_ns = time_lookups(&map, corpus.words, 0, half, &hits);
+    double miss_ns = time_lookups(&map, corpus.words, half, count, &false_hits);
+    printf("%zu slov v tabulce, %zu chybejicich klicu, %.2f prvku na radek\n",
+           map.count, count - half - false_hits,
+           (double)map.count / (double)map.size);
+    printf("bez filtru | hit %6.1f ns | miss %6.1f ns\n", hit_ns, miss_ns);
+
+    if (!ht_map_bloom_enable(&map, map.count)) {
+        fprintf(stderr, "bench_bloom: nedostatek pameti\n");
+        return 1;
+    }
+    size_t bloom_hits, bloom_false_hits;
+    double bloom_hit_ns = time_lookups(&map, corpus.words, 0, half, &bloom_hits);
+    double bloom_miss_ns =
+        time_lookups(&map, corpus.words, half, count, &bloom_false_hits);
+    printf("s filtrem  | hit %6.1f ns | miss %6.1f ns | zrychleni miss %.2fx "
+           "| %zu KiB\n",
+           bloom_hit_ns, bloom_miss_ns, miss_ns / bloom_miss_ns,
+           map.bloom->block_count * sizeof(ht_bloom_block_t) / 1024);
+
+    /* falesne pozitivni: filtr rekne "mozna", ale klic v tabulce neni */
+    size_t misses = 0, maybe = 0;
+    for (size_t i = half; i < count; i++) {
+        size_t length;
+        unsigned int hash = ht_map_key_hash(&map, corpus.words[i], &length);
+        if (ht_map_search_hashed(&map, corpus.words[i], length, hash) == NULL) {
+            misses++;
+            maybe += ht_bloom_may_contain(map.bloom, hash);
+        }
+    }
+    printf("falesne pozitivni %zu z %zu (%.2f %%), %d bitu na klic\n", maybe,
+           misses, 100.0 * (double)maybe / (double)misses,
+           HT_BLOOM_BITS_PER_KEY);
+    if (hits != bloom_hits || false_hits != bloom_false_hits) {
+        fprintf(stderr, "bench_bloom: filtr zmenil vysledky hledani\n");
+        return 1;
+    }
+
+    ht_map_destroy(&map);
+    bench_corpus_free(&corpus);
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * benchmark skalovani tabulek pro vice vlaken s poctem vlaken
+ *
+ * pro ht_conc_t (zamky po pruzich i pri cteni) a ht_lf_t (cteni bez zamku)
+ * a pro 1, 2, 4, ... az N vlaken rozdeli slova rovnym dilem mezi vlakna,
+ * ta je soubezne vlozi do prazdne tabulky a pak je soubezne vyhledaji;
+ * vypise propustnost v milionech operaci za sekundu
+ *
+ * ./bench_conc [max vlaken] [pocet slov] [soubor se slovy]
+ * (max vlaken je vychozi pocet jader)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "bench_util.h"
+#include "ht_conc.h"
+#include "ht_lf.h"
+
+#define DEFAULT_COUNT 1000000
+
+/* funkce jedne tabulky, at jde obe merit stejnym kodem */
+typedef struct table_ops {
+    const char *name;
+    size_t size;
+    bool (*init)(void *table);
+    void (*insert)(void *table, char *key, float value);
+    bool (*get)(void *table, char *key, float *value);
+    void (*destroy)(void *table);
+} table_ops_t;
+
+bool conc_init(void *t) { return ht_conc_init(t); }
+void conc_insert(void *t, char *k, float v) { ht_conc_insert(t, k, v); }
+bool conc_get(void *t, char *k, float *v) { return ht_conc_get(t, k, v); }
+void conc_destroy(void *t) { ht_conc_destroy(t); }
+
+bool lf_init(void *t) { return ht_lf_init(t); }
+void lf_insert(void *t, char *k, float v) { ht_lf_insert(t, k, v); }
+bool lf_get(void *t, char *k, float *v) { return ht_lf_get(t, k, v); }
+void lf_destroy(void *t) { ht_lf_destroy(t); }
+
+const table_ops_t TABLES[] = {
+    {"conc", sizeof(ht_conc_t), conc_init, conc_insert, conc_get, conc_destroy},
+    {"lf", sizeof(ht_lf_t), lf_init, lf_insert, lf_get, lf_destroy}};
+
+typedef struct worker {
+    pthread_t thread;
+    const table_ops_t *ops;
+    void *table;
+    char **words;
+    size_t count;
+    size_t found;
+} worker_t;
+
+void *insert_worker(void *arg) {
+    worker_t *w = arg;
+    for (size_t i = 0; i < w->count; i++) {
+        w->ops->insert(w->table, w->words[i], (float)i);
+    }
+    return NULL;
+}
+
+void *get_worker(void *arg) {
+    worker_t *w = arg;
+    float value;
+    for (size_t i = 0; i < w->count; i++) {
+        w->found += w->ops->get(w->table, w->words[i], &value);
+    }
+    return NULL;
+}
+
+/* pusti fn ve vsech vlaknech a vrati cas v ns */
+double run(worker_t *workers, unsigned int threads, void *(*fn)(void *)) {
+    double start = bench_now_ns();
+    for (unsigned int t = 0; t < threads; t++) {
+        pthread_create(&workers[t].thread, NULL, fn, &workers[t]);
+    }
+    for (unsigned int t = 0; t < threads; t++) {
+        pthread_join(workers[t].thread, NULL);
+    }
+    return bench_now_ns() - start;
+}
+
+int main(int argc, char *argv[]) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int max_threads = argc > 1 ? (unsigned int)strtoul(argv[1], NULL, 10)
+                                        : (unsigned int)(cores > 0 ? cores : 1);
+    size_t count = argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : DEFAULT_COUNT;
+    bench_corpus_t corpus;
+    bench_corpus_default(&corpus, argc > 3 ? argv[3] : NULL);
+    if (count == 0 || count > corpus.count) {
+        count = corpus.count;
+    }
+    if (max_threads == 0) {
+        max_threads = 1;
+    }
+
+    worker_t *workers = malloc(max_threads * sizeof(worker_t));
+    if (workers == NULL) {
+        fprintf(stderr, "bench_conc: nedostatek pameti\n");
+        return 1;
+    }
+
+    printf("%ld jader, %zu slov\n", cores, count);
+    for (size_t k = 0; k < sizeof(TABLES) / sizeof(TABLES[0]); k++) {
+        const table_ops_t *ops = &TABLES[k];
+        /* obe tabulky maji zamky zarovnane na radek cache */
+        void *table = aligned_alloc(64, ops->size);
+        if (table == NULL) {
+            fprintf(stderr, "bench_conc: nedostatek pameti\n");
+            return 1;
+        }
+
+        /* 1, 2, 4, ... a nakonec presne max_threads */
+        for (unsigned int threads = 1;;
+             threads = threads * 2 < max_threads ? threads * 2 : max_threads) {
+            if (!ops->init(table)) {
+                fprintf(stderr, "bench_conc: nedostatek pameti\n");
+                return 1;
+            }
+            for (unsigned int t = 0; t < threads; t++) {
+                size_t from = count * t / threads;
+                size_t to = count * (t + 1) / threads;
+                workers[t] = (worker_t){.ops = ops,
+                                        .table = table,
+                                        .words = corpus.words + from,
+                                        .count = to - from};
+            }
+
+            double insert_ns = run(workers, threads, insert_worker);
+            double get_ns = run(workers, threads, get_worker);
+            size_t found = 0;
+            for (unsigned int t = 0; t < threads; t++) {
+                found += workers[t].found;
+            }
+
+            printf("%-4s %2u vlaken | insert %6.2f Mops/s | get %6.2f Mops/s "
+                   "| nalezeno %zu\n",
+                   ops->name, threads, count / insert_ns * 1e3,
+                   count / get_ns * 1e3, found);
+            ops->destroy(table);
+            if (threads == max_threads) {
+                break;
+            }
+        }
+        free(table);
+    }
+
+    free(workers);
+    bench_corpus_free(&corpus);
+    return 0;
+}
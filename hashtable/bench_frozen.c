@@ -0,0 +1,126 @@
+/*
+ * benchmark zmrazene tabulky ht_frozen_t proti ht_map_t
+ *
+ * vypise cas stavby, pamet obou struktur (u ht_map_t bez rezie malloc)
+ * a cas uspesneho a neuspesneho vyhledani; pro studeny start porovna
+ * vkladani klicu po jednom s namapovanim souboru z ht_frozen_save
+ *
+ * ./bench_frozen [pocet slov] [soubor se slovy]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "bench_util.h"
+#include "ht_frozen.h"
+
+int main(int argc, char *argv[]) {
+    size_t count = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 0;
+    bench_corpus_t corpus, misses;
+    bench_corpus_default(&corpus, argc > 2 ? argv[2] : NULL);
+    if (count == 0 || count > corpus.count) {
+        count = corpus.count;
+    }
+    bench_corpus_synthetic(&misses, count, 2);
+
+    ht_map_t map;
+    ht_frozen_t frozen;
+    if (!ht_map_init(&map)) {
+        fprintf(stderr, "bench_frozen: nedostatek pameti\n");
+        return 1;
+    }
+    size_t map_bytes = 0;
+    double start = bench_now_ns();
+    for (size_t i = 0; i < count; i++) {
+        ht_map_insert(&map, corpus.words[i], (float)i);
+    }
+    double insert_ns = bench_now_ns() - start;
+    for (size_t i = 0; i < map.size; i++) {
+        for (ht_item_t *item = map.buckets[i]; item != NULL; item = item->next) {
+            map_bytes += sizeof(ht_item_t) + item->key_len + 1;
+        }
+    }
+    map_bytes += (map.size + map.old_size) * sizeof(ht_item_t *);
+
+    start = bench_now_ns();
+    if (!ht_map_freeze(&frozen, &map)) {
+        fprintf(stderr, "bench_frozen: nedostatek pameti\n");
+        return 1;
+    }
+    double build_ns = bench_now_ns() - start;
+    size_t index_bytes = frozen.bucket_count * frozen.width +
+                         (frozen.slot_count - frozen.count) * sizeof(uint32_t);
+    printf("%zu klicu | stavba %.1f ms | ht_map_t %.1f MB | ht_frozen_t %.1f MB"
+           " | index %.2f bitu na klic\n",
+           frozen.count, build_ns / 1e6, map_bytes / 1e6,
+           frozen.memory_size / 1e6, 8.0 * index_bytes / frozen.count);
+
+    size_t found = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < count; i++) {
+        found += ht_map_get(&map, corpus.words[i]) != NULL;
+    }
+    double map_hit_ns = bench_now_ns() - start;
+    start = bench_now_ns();
+    for (size_t i = 0; i < count; i++) {
+        found += ht_map_get(&map, misses.words[i]) != NULL;
+    }
+    double map_miss_ns = bench_now_ns() - start;
+
+    size_t frozen_found = 0;
+    start = bench_now_ns();
+    for (size_t i = 0; i < count; i++) {
+        frozen_found += ht_frozen_get(&frozen, corpus.words[i]) != NULL;
+    }
+    double frozen_hit_ns = bench_now_ns() - start;
+    start = bench_now_ns();
+    for (size_t i = 0; i < count; i++) {
+        frozen_found += ht_frozen_get(&frozen, misses.words[i]) != NULL;
+    }
+    double frozen_miss_ns = bench_now_ns() - start;
+
+    printf("ht_map_get    | hit %6.1f ns | miss %6.1f ns | nalezeno %zu\n",
+           map_hit_ns / count, map_miss_ns / count, found);
+    printf("ht_frozen_get | hit %6.1f ns | miss %6.1f ns | nalezeno %zu\n",
+           frozen_hit_ns / count, frozen_miss_ns / count, frozen_found);
+
+    /* studeny start: soubor je po zapisu v page cache, meri se mmap a prvni
+       pruchod vsemi klici vcetne vypadku stranek */
+    char path[] = "/tmp/bench_frozen_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        fprintf(stderr, "bench_frozen: nelze vytvorit docasny soubor\n");
+        return 1;
+    }
+    close(fd);
+    ht_frozen_t loaded;
+    start = bench_now_ns();
+    bool saved = ht_frozen_save(&frozen, path);
+    double save_ns = bench_now_ns() - start;
+    start = bench_now_ns();
+    if (!saved || !ht_frozen_load(&loaded, path)) {
+        fprintf(stderr, "bench_frozen: nelze ulozit %s\n", path);
+        unlink(path);
+        return 1;
+    }
+    double load_ns = bench_now_ns() - start;
+    size_t loaded_found = 0;
+    for (size_t i = 0; i < count; i++) {
+        loaded_found += ht_frozen_get(&loaded, corpus.words[i]) != NULL;
+    }
+    double first_pass_ns = bench_now_ns() - start - load_ns;
+    printf("studeny start | ht_map_insert %.1f ms | ht_frozen_save %.1f ms | "
+           "ht_frozen_load %.3f ms | prvni pruchod %.1f ms\n",
+           insert_ns / 1e6, save_ns / 1e6, load_ns / 1e6, first_pass_ns / 1e6);
+    ht_frozen_destroy(&loaded);
+    unlink(path);
+
+    ht_frozen_destroy(&frozen);
+    ht_map_destroy(&map);
+    bench_corpus_free(&corpus);
+    bench_corpus_free(&misses);
+    return found == frozen_found && loaded_found == count ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+/*
+ * benchmark rozptylovacich funkci
+ *
+ * pro kazdou funkci z ht_hash.h vypise cas na jeden hash a rozlozeni klicu
+ * do radku tabulky (histogram delek seznamu synonym a maximalni pocet kolizi
+ * stejne jako ht_print_table)
+ *
+ * ./bench_hash [soubor se slovy]
+ * bez souboru se zkusi /usr/share/dict/words, jinak se vygeneruje WRD_CNT slov
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "hashtable.h"
+#include "ht_hash.h"
+#include "test_words.h"
+
+/* kolik hashu se minimalne spocita pri mereni casu */
+#define MIN_HASHES 4000000
+
+/* delky seznamu >= HISTOGRAM_MAX se scitaji do posledniho sloupce */
+#define HISTOGRAM_MAX 8
+
+typedef struct bench_hash_fn {
+    const char *name;
+    ht_hash_fn_t fn;
+} bench_hash_fn_t;
+
+static const bench_hash_fn_t HASHES[] = {
+    {"additive", ht_hash_additive},
+    {"fnv1a", ht_hash_fnv1a},
+    {"wyhash", ht_hash_wy},
+};
+
+static size_t next_prime(size_t n) {
+    for (;; n++) {
+        size_t d = 2;
+        while (d * d <= n && n % d != 0) {
+            d++;
+        }
+        if (n >= 2 && d * d > n) {
+            return n;
+        }
+    }
+}
+
+/* rozhodi klice do size radku a vypise histogram delek seznamu */
+void print_distribution(const bench_corpus_t *corpus, ht_hash_fn_t fn,
+                        size_t size) {
+    unsigned int *counts = calloc(size, sizeof(unsigned int));
+    if (counts == NULL) {
+        fprintf(stderr, "bench_hash: nedostatek pameti\n");
+        exit(1);
+    }
+    for (size_t i = 0; i < corpus->count; i++) {
+        uint64_t hash = fn(corpus->words[i], corpus->lengths[i], 0);
+        counts[ht_hash_fold(hash) % size]++;
+    }
+
+    size_t histogram[HISTOGRAM_MAX + 1] = {0};
+    unsigned int max_count = 0;
+    for (size_t i = 0; i < size; i++) {
+        unsigned int c = counts[i];
+        histogram[c < HISTOGRAM_MAX ? c : HISTOGRAM_MAX]++;
+        if (c > max_count) {
+            max_count = c;
+        }
+    }
+
+    printf("    %8zu radku |", size);
+    for (int i = 0; i <= HISTOGRAM_MAX; i++) {
+        printf(" %s%d:%zu", i == HISTOGRAM_MAX ? ">=" : "", i, histogram[i]);
+    }
+    printf(" | max kolizi: %u\n", max_count == 0 ? 0 : max_count - 1);
+    free(counts);
+}
+
+/* zmeri prumerny cas jednoho hashe */
+double measure_ns(const bench_corpus_t *corpus, ht_hash_fn_t fn) {
+    size_t reps = MIN_HASHES / corpus->count + 1;
+    volatile uint64_t sink = 0;
+    uint64_t acc = 0;
+    double start = bench_now_ns();
+    for (size_t r = 0; r < reps; r++) {
+        for (size_t i = 0; i < corpus->count; i++) {
+            acc ^= fn(corpus->words[i], corpus->lengths[i], r);
+        }
+    }
+    double elapsed = bench_now_ns() - start;
+    sink = acc;
+    (void)sink;
+    return elapsed / (double)(reps * corpus->count);
+}
+
+void run(const char *title, const bench_corpus_t *corpus) {
+    printf("=== %s: %zu slov ===\n", title, corpus->count);
+    for (size_t h = 0; h < sizeof(HASHES) / sizeof(HASHES[0]); h++) {
+        printf("  %-8s %6.2f ns/hash\n", HASHES[h].name,
+               measure_ns(corpus, HASHES[h].fn));
+        print_distribution(corpus, HASHES[h].fn, MAX_HT_SIZE);
+        print_distribution(corpus, HASHES[h].fn, next_prime(corpus->count));
+    }
+    printf("\n");
+}
+
+int main(int argc, char *argv[]) {
+    bench_corpus_t corpus;
+
+    bench_corpus_from_words(&corpus, words, word_count);
+    run("test_muj_2.c", &corpus);
+    bench_corpus_free(&corpus);
+
+    bench_corpus_default(&corpus, argc > 1 ? argv[1] : NULL);
+    run("slovnik", &corpus);
+    bench_corpus_free(&corpus);
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * hromadne nacteni slovniku: ht_load_file proti read_word z test_muj.c
+ *
+ * nejdriv nacte soubor po znacich pres fgetc jako test_muj.c (jedno
+ * vlakno, ht_map_t), pak pres ht_load_file s 1, 2, 4, ... az N vlakny;
+ * vypise cas a propustnost v MB/s. bez souboru se zkusi
+ * /usr/share/dict/words, jinak se vygeneruje WRD_CNT slov do docasneho
+ * souboru
+ *
+ * ./bench_load [soubor se slovy] [max vlaken]
+ * (max vlaken je vychozi pocet jader)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "bench_util.h"
+#include "ht_load.h"
+
+#define MAX_WORD_LEN 1024
+
+/* read_word z test_muj.c */
+int read_word(char *s, int max, FILE *f) {
+    int c;
+    while (isspace(c = fgetc(f)) && c != EOF) {
+    }
+    if (c == EOF) {
+        return EOF;
+    }
+    s[0] = c;
+    int i;
+    for (i = 1; i < max - 1; i++) {
+        c = fgetc(f);
+        if (c == EOF || isspace(c)) {
+            break;
+        }
+        s[i] = c;
+    }
+    s[i] = '\0';
+    return i;
+}
+
+/* zapise slova do docasneho souboru, po jednom na radek */
+void write_corpus(const char *path, bench_corpus_t *corpus) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "bench_load: nelze zapsat %s\n", path);
+        exit(1);
+    }
+    for (size_t i = 0; i < corpus->count; i++) {
+        fputs(corpus->words[i], f);
+        fputc('\n', f);
+    }
+    fclose(f);
+}
+
+int main(int argc, char *argv[]) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int max_threads = argc > 2 ? (unsigned int)strtoul(argv[2], NULL, 10)
+                                        : (unsigned int)(cores > 0 ? cores : 1);
+    if (max_threads == 0) {
+        max_threads = 1;
+    }
+
+    char tmp_path[] = "/tmp/bench_load_XXXXXX";
+    const char *path = argc > 1 ? argv[1] : NULL;
+    if (path == NULL) {
+        bench_corpus_t corpus;
+        bench_corpus_default(&corpus, NULL);
+        int fd = mkstemp(tmp_path);
+        if (fd < 0) {
+            fprintf(stderr, "bench_load: nelze vytvorit docasny soubor\n");
+            return 1;
+        }
+        close(fd);
+        write_corpus(tmp_path, &corpus);
+        bench_corpus_free(&corpus);
+        path = tmp_path;
+    }
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        fprintf(stderr, "bench_load: nelze nacist %s\n", path);
+        return 1;
+    }
+    double mb = (double)st.st_size / 1e6;
+
+    FILE *f = fopen(path, "r");
+    ht_map_t map;
+    if (f == NULL || !ht_map_init(&map)) {
+        fprintf(stderr, "bench_load: nelze nacist %s\n", path);
+        return 1;
+    }
+    char word[MAX_WORD_LEN];
+    size_t words = 0;
+    double start = bench_now_ns();
+    while (read_word(word, MAX_WORD_LEN, f) != EOF) {
+        ht_map_increment(&map, word);
+        words++;
+    }
+    double stdio_ns = bench_now_ns() - start;
+    fclose(f);
+    printf("%ld jader, %.1f MB, %zu slov, %zu ruznych\n", cores, mb, words,
+           map.count);
+    printf("fgetc            | %7.1f ms | %7.1f MB/s\n", stdio_ns / 1e6,
+           mb / (stdio_ns / 1e9));
+    ht_map_destroy(&map);
+
+    /* 1, 2, 4, ... a nakonec presne max_threads */
+    for (unsigned int threads = 1;;
+         threads = threads * 2 < max_threads ? threads * 2 : max_threads) {
+        ht_shard_t table;
+        if (!ht_shard_init(&table)) {
+            fprintf(stderr, "bench_load: nedostatek pameti\n");
+            return 1;
+        }
+        start = bench_now_ns();
+        if (!ht_load_file(&table, path, threads, &words)) {
+            fprintf(stderr, "bench_load: nelze nacist %s\n", path);
+            return 1;
+        }
+        double load_ns = bench_now_ns() - start;
+        printf("mmap %2u vlaken   | %7.1f ms | %7.1f MB/s | %zu slov, %zu "
+               "ruznych\n",
+               threads, load_ns / 1e6, mb / (load_ns / 1e9), words,
+               ht_shard_count(&table));
+        ht_shard_destroy(&table);
+        if (threads == max_threads) {
+            break;
+        }
+    }
+
+    if (path == tmp_path) {
+        unlink(tmp_path);
+    }
+    return 0;
+}
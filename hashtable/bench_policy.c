@@ -0,0 +1,149 @@
+/*
+ * benchmark samoorganizujicich seznamu synonym v ht_handle_t: bez
+ * presouvani, move-to-front a transpozice
+ *
+ * slova z test_words.c (jako v test_muj_2.c) se hledaji se Zipfovym
+ * rozdelenim (k-te nejcastejsi slovo ma vahu 1/k^s, poradi slov je nahodne);
+ * pro kazdou politiku vypise prumerny pocet prvku seznamu prosly pri jednom
+ * vyhledani a cas vyhledani
+ *
+ * ./bench_policy [s] [pocet radku, mocnina dvojky]
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "hashtable.h"
+#include "test_words.h"
+
+/* pocet vyhledani v jednom mereni */
+#define LOOKUPS 1000000
+
+/* index radku jako v ht_handle_index pro velikost 2^k */
+static inline size_t index_of(unsigned int hash, unsigned int shift) {
+    return (size_t)((hash * 0x9E3779B97F4A7C15ull) >> shift);
+}
+
+/* xorshift64, aby posloupnost byla na vsech strojich stejna */
+static uint64_t next_random(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/* posloupnost LOOKUPS indexu slov se Zipfovym rozdelenim s exponentem s */
+unsigned int *zipf_sequence(double s) {
+    double *cdf = malloc(word_count * sizeof(double));
+    unsigned int *rank = malloc(word_count * sizeof(unsigned int));
+    unsigned int *sequence = malloc(LOOKUPS * sizeof(unsigned int));
+    if (cdf == NULL || rank == NULL || sequence == NULL) {
+        fprintf(stderr, "bench_policy: nedostatek pameti\n");
+        exit(1);
+    }
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+    double sum = 0;
+    for (unsigned int k = 0; k < word_count; k++) {
+        sum += 1.0 / pow(k + 1, s);
+        cdf[k] = sum;
+        rank[k] = k;
+    }
+    /* nahodne prirazeni poradi slovum, nejcastejsi nejsou prvni vlozena */
+    for (unsigned int k = word_count - 1; k > 0; k--) {
+        unsigned int j = (unsigned int)(next_random(&state) % (k + 1));
+        unsigned int t = rank[k];
+        rank[k] = rank[j];
+        rank[j] = t;
+    }
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        double u = (double)(next_random(&state) >> 11) / 9007199254740992.0;
+        u *= sum;
+        unsigned int lo = 0, hi = word_count - 1;
+        while (lo < hi) {
+            unsigned int mid = (lo + hi) / 2;
+            if (cdf[mid] < u) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        sequence[i] = rank[lo];
+    }
+    free(cdf);
+    free(rank);
+    return sequence;
+}
+
+void fill(ht_handle_t *table, size_t size, ht_policy_t policy) {
+    ht_handle_config_t config = {.size = size, .policy = policy};
+    if (!ht_handle_init(table, &config)) {
+        fprintf(stderr, "bench_policy: nedostatek pameti\n");
+        exit(1);
+    }
+    for (unsigned int i = 0; i < word_count; i++) {
+        ht_handle_insert(table, words[i], (float)i);
+    }
+}
+
+/* prumerny pocet prvku prosly pri vyhledani s politikou policy */
+double visited(size_t size, ht_policy_t policy, unsigned int *sequence) {
+    ht_handle_t table;
+    fill(&table, size, policy);
+    size_t total = 0;
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        char *key = words[sequence[i]];
+        /* pozice klice v radku pred vyhledanim, to seznam jeste nezmeni */
+        table.policy = HT_POLICY_NONE;
+        ht_item_t *found = ht_handle_search(&table, key);
+        ht_item_t *item = table.buckets[index_of(found->hash, table.shift)];
+        for (; item != found; item = item->next) {
+            total++;
+        }
+        total++;
+        table.policy = policy;
+        ht_handle_search(&table, key);
+    }
+    ht_handle_destroy(&table);
+    return (double)total / LOOKUPS;
+}
+
+/* prumerny cas jednoho vyhledani v ns */
+double lookup_ns(size_t size, ht_policy_t policy, unsigned int *sequence) {
+    ht_handle_t table;
+    fill(&table, size, policy);
+    size_t found = 0;
+    double start = bench_now_ns();
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        found += ht_handle_search(&table, words[sequence[i]]) != NULL;
+    }
+    double elapsed = bench_now_ns() - start;
+    ht_handle_destroy(&table);
+    if (found != LOOKUPS) {
+        fprintf(stderr, "bench_policy: nenalezeny klice\n");
+        exit(1);
+    }
+    return elapsed / LOOKUPS;
+}
+
+int main(int argc, char *argv[]) {
+    double s = argc > 1 ? strtod(argv[1], NULL) : 1.0;
+    size_t size = argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : 0;
+    if (size < 2 || (size & (size - 1)) != 0) {
+        size = 128;
+    }
+    unsigned int *sequence = zipf_sequence(s);
+    const char *names[] = {"bez presouvani", "move-to-front", "transpozice"};
+    ht_policy_t policies[] = {HT_POLICY_NONE, HT_POLICY_MOVE_TO_FRONT,
+                              HT_POLICY_TRANSPOSE};
+    printf("%u slov, %zu radku (%.1f na radek), Zipf s = %.2f, %d hledani\n",
+           word_count, size, (double)word_count / size, s, LOOKUPS);
+    for (int p = 0; p < 3; p++) {
+        printf("%-14s | prosle prvky %5.2f | hledani %6.1f ns\n", names[p],
+               visited(size, policies[p], sequence),
+               lookup_ns(size, policies[p], sequence));
+    }
+    free(sequence);
+    return 0;
+}
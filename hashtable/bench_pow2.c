@@ -0,0 +1,136 @@
+/*
+ * benchmark velikosti pole ht_map_t: prvocislo a modulo proti mocnine dvojky
+ * s Fibonacciho hashovanim (ht_map_init_pow2)
+ *
+ * pro malou tabulku (vejde se do cache, deleni je videt nejvic) a pro
+ * tabulku se vsemi slovy meri zvlast samotny vypocet indexu z hotovych
+ * hashu, vkladani a uspesne i neuspesne hledani
+ *
+ * ./bench_pow2 [pocet slov] [soubor se slovy]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "ht_map.h"
+
+/* kolikrat se kazde mereni zopakuje, at cas neni moc kratky */
+#define ROUNDS 5
+
+typedef bool (*init_t)(ht_map_t *map);
+
+typedef struct result {
+  double index_ns;  // vypocet indexu z hashe
+  double insert_ns; // ht_map_insert
+  double hit_ns;    // ht_map_get pro klic v tabulce
+  double miss_ns;   // ht_map_get pro chybejici klic
+  size_t size;      // velikost pole po vlozeni
+} result_t;
+
+/* index radku jako v ht_map_index */
+static inline size_t index_of(unsigned int hash, size_t size,
+                              unsigned int shift) {
+    if (shift != 0) {
+        return (size_t)((hash * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+    return hash % size;
+}
+
+result_t measure(init_t init, bench_corpus_t *corpus, bench_corpus_t *misses,
+                 size_t count, unsigned int *hashes) {
+    result_t r = {0};
+    ht_map_t map;
+    size_t found = 0;
+    for (unsigned int round = 0; round < ROUNDS; round++) {
+        if (!init(&map)) {
+            fprintf(stderr, "bench_pow2: nedostatek pameti\n");
+            exit(1);
+        }
+        double start = bench_now_ns();
+        for (size_t i = 0; i < count; i++) {
+            ht_map_insert(&map, corpus->words[i], (float)i);
+        }
+        r.insert_ns += bench_now_ns() - start;
+
+        start = bench_now_ns();
+        for (size_t i = 0; i < count; i++) {
+            found += ht_map_get(&map, corpus->words[i]) != NULL;
+        }
+        r.hit_ns += bench_now_ns() - start;
+        start = bench_now_ns();
+        for (size_t i = 0; i < count; i++) {
+            found += ht_map_get(&map, misses->words[i]) != NULL;
+        }
+        r.miss_ns += bench_now_ns() - start;
+
+        /* size je za behu promenna, prekladac deleni nenahradi nasobenim */
+        size_t sink = 0;
+        start = bench_now_ns();
+        for (size_t i = 0; i < count; i++) {
+            sink += index_of(hashes[i], map.size, map.shift);
+        }
+        r.index_ns += bench_now_ns() - start;
+        found += sink == 0;
+        r.size = map.size;
+        ht_map_destroy(&map);
+    }
+    double per_op = (double)ROUNDS * (double)count;
+    r.index_ns /= per_op;
+    r.insert_ns /= per_op;
+    r.hit_ns /= per_op;
+    r.miss_ns /= per_op;
+    if (found < count) {
+        fprintf(stderr, "bench_pow2: nenalezeny klice\n");
+        exit(1);
+    }
+    return r;
+}
+
+void print_result(const char *name, result_t *r) {
+    printf("%-14s | pole %8zu | index %5.2f ns | insert %6.1f ns | hit %6.1f "
+           "ns | miss %6.1f ns\n",
+           name, r->size, r->index_ns, r->insert_ns, r->hit_ns, r->miss_ns);
+}
+
+int main(int argc, char *argv[]) {
+    size_t count = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 0;
+    bench_corpus_t corpus, misses;
+    bench_corpus_default(&corpus, argc > 2 ? argv[2] : NULL);
+    if (count == 0 || count > corpus.count) {
+        count = corpus.count;
+    }
+    bench_corpus_synthetic(&misses, count, 2);
+
+    ht_map_t map;
+    unsigned int *hashes = malloc(count * sizeof(unsigned int));
+    if (hashes == NULL || !ht_map_init(&map)) {
+        fprintf(stderr, "bench_pow2: nedostatek pameti\n");
+        return 1;
+    }
+    for (size_t i = 0; i < count; i++) {
+        size_t length;
+        hashes[i] = ht_map_key_hash(&map, corpus.words[i], &length);
+    }
+    ht_map_destroy(&map);
+
+    size_t sizes[] = {count / 64 + 1, count};
+    for (size_t s = 0; s < 2; s++) {
+        printf("%zu slov\n", sizes[s]);
+        result_t prime =
+            measure(ht_map_init, &corpus, &misses, sizes[s], hashes);
+        result_t pow2 =
+            measure(ht_map_init_pow2, &corpus, &misses, sizes[s], hashes);
+        print_result("prvocislo %", &prime);
+        print_result("2^k, nasobeni", &pow2);
+        printf("zrychleni      | index %.2fx | insert %.2fx | hit %.2fx | "
+               "miss %.2fx\n",
+               prime.index_ns / pow2.index_ns, prime.insert_ns / pow2.insert_ns,
+               prime.hit_ns / pow2.hit_ns, prime.miss_ns / pow2.miss_ns);
+    }
+
+    free(hashes);
+    bench_corpus_free(&corpus);
+    bench_corpus_free(&misses);
+    return 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * benchmark tabulky Robin Hood pri vysokem zaplneni
+ *
+ * tabulku s pevnou kapacitou naplni na 0.80 az 0.99 a pro kazde zaplneni
+ * vypise prumer, rozptyl a maximum vzdalenosti od domovskeho slotu a cas
+ * uspesneho a neuspesneho vyhledani
+ *
+ * ./bench_robin [soubor se slovy]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_util.h"
+#include "ht_robin.h"
+
+/* kapacita tabulky, pro kazde zaplneni stejna (tabulka neroste) */
+#define CAPACITY (1u << 19)
+
+static const unsigned int LOADS[] = {80, 90, 95, 99};
+
+int main(int argc, char *argv[]) {
+    bench_corpus_t corpus, misses;
+    bench_corpus_default(&corpus, argc > 1 ? argv[1] : NULL);
+    bench_corpus_synthetic(&misses, CAPACITY, 2);
+
+    for (size_t l = 0; l < sizeof(LOADS) / sizeof(LOADS[0]); l++) {
+        ht_robin_t table;
+        if (!ht_robin_init_load(&table, 99)) {
+            fprintf(stderr, "bench_robin: nedostatek pameti\n");
+            return 1;
+        }
+        /* nejdriv dorovna kapacitu, pak plni jen do zvoleneho zaplneni */
+        size_t count = (size_t)CAPACITY * LOADS[l] / 100;
+        if (count > corpus.count) {
+            count = corpus.count;
+        }
+        for (size_t i = 0; table.capacity < CAPACITY && i < count; i++) {
+            ht_robin_insert(&table, corpus.words[i], (float)i);
+        }
+        for (size_t i = 0; i < count; i++) {
+            ht_robin_insert(&table, corpus.words[i], (float)i);
+        }
+
+        ht_robin_stats_t stats;
+        ht_robin_stats(&table, &stats);
+
+        size_t found = 0;
+        double start = bench_now_ns();
+        for (size_t i = 0; i < count; i++) {
+            found += ht_robin_get(&table, corpus.words[i]) != NULL;
+        }
+        double hit_ns = (bench_now_ns() - start) / count;
+
+        size_t missed = 0;
+        start = bench_now_ns();
+        for (size_t i = 0; i < count; i++) {
+            missed += ht_robin_get(&table, misses.words[i]) == NULL;
+        }
+        double miss_ns = (bench_now_ns() - start) / count;
+
+        printf("zaplneni %.3f | vzdalenost prumer %5.2f rozptyl %6.2f "
+               "max %3u | hit %6.1f ns | miss %6.1f ns (%zu/%zu)\n",
+               stats.load, stats.mean_dist, stats.var_dist, stats.max_dist,
+               hit_ns, miss_ns, found, missed);
+        ht_robin_destroy(&table);
+    }
+
+    bench_corpus_free(&corpus);
+    bench_corpus_free(&misses);
+    return 0;
+}
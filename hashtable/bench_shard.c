@@ -0,0 +1,146 @@
+/*
+ * benchmark agregace pres delene tabulky ht_shard_t
+ *
+ * proud slov (kazde slovo ze seznamu nekolikrat, v promichanem poradi,
+ * jako pri nacitani slovniku v test_muj.c) se rozdeli mezi vlakna, kazde
+ * pocita vyskyty do sve tabulky a nakonec se tabulky paralelne sectou;
+ * pro srovnani se vypise i jedno vlakno s jedinou ht_map_t
+ *
+ * ./bench_shard [max vlaken] [pocet slov] [soubor se slovy]
+ * (max vlaken je vychozi pocet jader)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "bench_util.h"
+#include "ht_shard.h"
+
+#define DEFAULT_COUNT 200000
+
+/* kolikrat se v proudu objevi kazde slovo */
+#define REPEATS 4
+
+typedef struct worker {
+    pthread_t thread;
+    ht_shard_t shard;
+    char **stream;
+    size_t count;
+} worker_t;
+
+void *count_worker(void *arg) {
+    worker_t *w = arg;
+    for (size_t i = 0; i < w->count; i++) {
+        ht_shard_add(&w->shard, w->stream[i], 1.0);
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int max_threads = argc > 1 ? (unsigned int)strtoul(argv[1], NULL, 10)
+                                        : (unsigned int)(cores > 0 ? cores : 1);
+    size_t count = argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : DEFAULT_COUNT;
+    bench_corpus_t corpus;
+    bench_corpus_default(&corpus, argc > 3 ? argv[3] : NULL);
+    if (count == 0 || count > corpus.count) {
+        count = corpus.count;
+    }
+    if (max_threads == 0) {
+        max_threads = 1;
+    }
+
+    /* proud s REPEATS vyskyty kazdeho slova, promichany */
+    size_t tokens = count * REPEATS;
+    char **stream = malloc(tokens * sizeof(char *));
+    worker_t *workers = malloc(max_threads * sizeof(worker_t));
+    if (stream == NULL || workers == NULL) {
+        fprintf(stderr, "bench_shard: nedostatek pameti\n");
+        return 1;
+    }
+    for (size_t i = 0; i < tokens; i++) {
+        stream[i] = corpus.words[i % count];
+    }
+    unsigned long long state = 88172645463325252ull;
+    for (size_t i = tokens - 1; i > 0; i--) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        size_t j = state % (i + 1);
+        char *tmp = stream[i];
+        stream[i] = stream[j];
+        stream[j] = tmp;
+    }
+
+    ht_map_t single;
+    if (!ht_map_init(&single)) {
+        fprintf(stderr, "bench_shard: nedostatek pameti\n");
+        return 1;
+    }
+    double start = bench_now_ns();
+    for (size_t i = 0; i < tokens; i++) {
+        ht_map_increment(&single, stream[i]);
+    }
+    double single_ns = bench_now_ns() - start;
+    printf("%ld jader, %zu slov, %zu vyskytu\n", cores, count, tokens);
+    printf("ht_map    1 vlakno | plneni %7.1f ms | %zu ruznych slov\n",
+           single_ns / 1e6, single.count);
+    ht_map_destroy(&single);
+
+    /* 1, 2, 4, ... a nakonec presne max_threads */
+    for (unsigned int threads = 1;;
+         threads = threads * 2 < max_threads ? threads * 2 : max_threads) {
+        for (unsigned int t = 0; t < threads; t++) {
+            size_t from = tokens * t / threads;
+            size_t to = tokens * (t + 1) / threads;
+            workers[t].stream = stream + from;
+            workers[t].count = to - from;
+            if (!ht_shard_init(&workers[t].shard)) {
+                fprintf(stderr, "bench_shard: nedostatek pameti\n");
+                return 1;
+            }
+        }
+
+        start = bench_now_ns();
+        for (unsigned int t = 0; t < threads; t++) {
+            pthread_create(&workers[t].thread, NULL, count_worker, &workers[t]);
+        }
+        for (unsigned int t = 0; t < threads; t++) {
+            pthread_join(workers[t].thread, NULL);
+        }
+        double fill_ns = bench_now_ns() - start;
+
+        /* vsechny tabulky se sectou do prvni */
+        ht_shard_t *shards = malloc(threads * sizeof(ht_shard_t));
+        if (shards == NULL) {
+            fprintf(stderr, "bench_shard: nedostatek pameti\n");
+            return 1;
+        }
+        for (unsigned int t = 0; t < threads; t++) {
+            shards[t] = workers[t].shard;
+        }
+        start = bench_now_ns();
+        ht_shard_merge(&shards[0], shards, threads, ht_shard_sum, threads);
+        double merge_ns = bench_now_ns() - start;
+
+        printf("ht_shard %2u vlaken | plneni %7.1f ms | slouceni %7.1f ms "
+               "| %zu ruznych slov\n",
+               threads, fill_ns / 1e6, merge_ns / 1e6,
+               ht_shard_count(&shards[0]));
+        for (unsigned int t = 0; t < threads; t++) {
+            ht_shard_destroy(&shards[t]);
+        }
+        free(shards);
+        if (threads == max_threads) {
+            break;
+        }
+    }
+
+    free(workers);
+    free(stream);
+    bench_corpus_free(&corpus);
+    return 0;
+}
@@ -0,0 +1,164 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_util.h"
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* slovnik, ktery se zkusi nacist kdyz neni zadany zadny soubor */
+#define BENCH_DICT_PATH "/usr/share/dict/words"
+
+double bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void bench_corpus_alloc(bench_corpus_t *corpus, size_t count) {
+  corpus->words = malloc(count * sizeof(char *));
+  corpus->lengths = malloc(count * sizeof(size_t));
+  corpus->count = 0;
+  corpus->storage = NULL;
+  if (corpus->words == NULL || corpus->lengths == NULL) {
+    fprintf(stderr, "bench: nedostatek pameti\n");
+    exit(1);
+  }
+}
+
+void bench_corpus_from_words(bench_corpus_t *corpus, char **words,
+                             size_t count) {
+  bench_corpus_alloc(corpus, count);
+  for (size_t i = 0; i < count; i++) {
+    corpus->words[i] = words[i];
+    corpus->lengths[i] = strlen(words[i]);
+  }
+  corpus->count = count;
+}
+
+int bench_corpus_load(bench_corpus_t *corpus, const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (f == NULL) {
+    return -1;
+  }
+  fseek(f, 0, SEEK_END);
+  long size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  if (size < 0) {
+    fclose(f);
+    return -1;
+  }
+
+  char *storage = malloc((size_t)size + 1);
+  if (storage == NULL || fread(storage, 1, (size_t)size, f) != (size_t)size) {
+    free(storage);
+    fclose(f);
+    return -1;
+  }
+  fclose(f);
+  storage[size] = '\0';
+
+  /* nejdriv spocita slova, pak je rozdeli na miste */
+  size_t count = 0;
+  for (long i = 0; i < size; i++) {
+    if (!isspace((unsigned char)storage[i]) &&
+        (i == 0 || isspace((unsigned char)storage[i - 1]))) {
+      count++;
+    }
+  }
+  bench_corpus_alloc(corpus, count);
+  corpus->storage = storage;
+
+  char *p = storage;
+  while (*p != '\0') {
+    while (*p != '\0' && isspace((unsigned char)*p)) {
+      p++;
+    }
+    if (*p == '\0') {
+      break;
+    }
+    char *start = p;
+    while (*p != '\0' && !isspace((unsigned char)*p)) {
+      p++;
+    }
+    corpus->words[corpus->count] = start;
+    corpus->lengths[corpus->count] = (size_t)(p - start);
+    corpus->count++;
+    if (*p != '\0') {
+      *p++ = '\0';
+    }
+  }
+  return 0;
+}
+
+static unsigned long long bench_xorshift(unsigned long long *state) {
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+void bench_corpus_synthetic(bench_corpus_t *corpus, size_t count,
+                            unsigned int seed) {
+  /* slova o delce 5-16 znaku, cast s velkym pismenem nebo koncovkou 's */
+  bench_corpus_alloc(corpus, count);
+  corpus->storage = malloc(count * 20);
+  if (corpus->storage == NULL) {
+    fprintf(stderr, "bench: nedostatek pameti\n");
+    exit(1);
+  }
+
+  unsigned long long state = 0x9E3779B97F4A7C15ull ^ seed;
+  char *p = corpus->storage;
+  for (size_t i = 0; i < count; i++) {
+    unsigned long long r = bench_xorshift(&state);
+    size_t len = 5 + r % 12;
+    bool capital = r % 10 == 0;
+    bool plural = r % 5 == 1;
+
+    corpus->words[i] = p;
+    for (size_t j = 0; j < len; j++) {
+      if (j % 8 == 0) {
+        r = bench_xorshift(&state);
+      }
+      p[j] = (char)('a' + (r >> (8 * (j % 8))) % 26);
+    }
+    if (capital) {
+      p[0] = (char)toupper((unsigned char)p[0]);
+    }
+    if (plural) {
+      p[len++] = '\'';
+      p[len++] = 's';
+    }
+    p[len] = '\0';
+    corpus->lengths[i] = len;
+    p += len + 1;
+  }
+  corpus->count = count;
+}
+
+void bench_corpus_default(bench_corpus_t *corpus, const char *path) {
+  if (path != NULL) {
+    if (bench_corpus_load(corpus, path) != 0) {
+      fprintf(stderr, "bench: nelze nacist %s\n", path);
+      exit(1);
+    }
+    return;
+  }
+  if (bench_corpus_load(corpus, BENCH_DICT_PATH) == 0) {
+    return;
+  }
+  bench_corpus_synthetic(corpus, WRD_CNT, 1);
+}
+
+void bench_corpus_free(bench_corpus_t *corpus) {
+  free(corpus->words);
+  free(corpus->lengths);
+  free(corpus->storage);
+  corpus->words = NULL;
+  corpus->lengths = NULL;
+  corpus->storage = NULL;
+  corpus->count = 0;
+}
@@ -0,0 +1,27 @@
+#ifndef IAL_HASHTABLE_BENCH_UTIL_H
+#define IAL_HASHTABLE_BENCH_UTIL_H
+
+#include <stddef.h>
+
+/* pocet slov v /usr/share/dict/american-english-insane (viz test_muj.c) */
+#define WRD_CNT 654936
+
+/* seznam slov pro benchmarky */
+typedef struct bench_corpus {
+  char **words;    // ukazatele na slova ukoncena nulou
+  size_t *lengths; // delky slov
+  size_t count;    // pocet slov
+  char *storage;   // jeden blok se vsemi slovy
+} bench_corpus_t;
+
+double bench_now_ns(void);
+
+void bench_corpus_from_words(bench_corpus_t *corpus, char **words,
+                             size_t count);
+int bench_corpus_load(bench_corpus_t *corpus, const char *path);
+void bench_corpus_synthetic(bench_corpus_t *corpus, size_t count,
+                            unsigned int seed);
+void bench_corpus_default(bench_corpus_t *corpus, const char *path);
+void bench_corpus_free(bench_corpus_t *corpus);
+
+#endif
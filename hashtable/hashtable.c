@@ -6,26 +6,178 @@
  * zretězenými synonymy.
  *
  * Při implementaci uvažujte velikost tabulky HT_SIZE.
+ *
+ * Všechny operace jsou napsané pro ht_handle_t, tabulku s vlastní
+ * velikostí, rozptylovací funkcí a alokátorem. Funkce pro ht_table_t jen
+ * nad polem tabulky a globální velikostí HT_SIZE sestaví pohled typu
+ * ht_handle_t (ht_table_view) a zavolají odpovídající funkci ht_handle_*.
  */
 
 #include "hashtable.h"
+#include "ht_hash.h"
+#include "ht_item.h"
 #include <stdlib.h>
 #include <string.h>
 
 int HT_SIZE = MAX_HT_SIZE;
 
+/*
+ * Celý hash klíče délky length před zúžením na index tabulky. Klíč nemusí
+ * být ukončený nulou.
+ */
+static unsigned int ht_full_hash(ht_handle_t *table, const char *key,
+                                 size_t length) {
+  if (table->hash != NULL) {
+    return ht_hash_fold(table->hash(key, length, table->seed));
+  }
+#if HT_TABLE_HASH == HT_HASH_ADDITIVE
+  unsigned int result = 1 + (unsigned int)table->seed;
+  for (size_t i = 0; i < length; i++) {
+    result += key[i];
+  }
+  return result;
+#else
+  // Build-time selected hash, see ht_hash.h
+  return ht_hash_fold(ht_hash_table(key, length, table->seed));
+#endif
+}
+
+/*
+ * Index řádku pro hash. Velikost 2^k bere horních k bitů součinu hashe se
+ * zlatým řezem 2^64 (jako ht_map_init_pow2), ostatní velikosti zbytek po
+ * dělení: s předpočítaným fastmod dvěma násobeními (Lemire, fastmod_u32),
+ * bez něj operátorem %.
+ */
+static inline size_t ht_handle_index(const ht_handle_t *table,
+                                     unsigned int hash) {
+  if (table->shift != 0) {
+    return (size_t)((hash * 0x9E3779B97F4A7C15ull) >> table->shift);
+  }
+  if (table->fastmod != 0) {
+    // High 64 bits of lowbits * size, size fits in 32 bits
+    uint64_t lowbits = table->fastmod * hash;
+    uint64_t low = (lowbits & UINT32_MAX) * table->size;
+    uint64_t high = (lowbits >> 32) * table->size;
+    return (size_t)((high + (low >> 32)) >> 32);
+  }
+  return hash % table->size;
+}
+
+/*
+ * Pohled typu ht_handle_t na tabulku s pevnou velikostí. Pole ani velikost
+ * se nekopírují; pohled platí do změny HT_SIZE. Index se počítá operátorem
+ * %, předpočítání fastmod by stálo stejné dělení, jaké má ušetřit.
+ */
+static inline ht_handle_t ht_table_view(ht_table_t *table) {
+  return (ht_handle_t){.buckets = *table,
+                       .size = (size_t)HT_SIZE,
+                       .seed = HT_HASH_SEED,
+                       .policy = HT_TABLE_POLICY};
+}
+
+/*
+ * Vytvoření prvku pomocí alokátoru tabulky. Pro klíč delší než
+ * HT_ITEM_MAX_KEY vrací NULL.
+ */
+static ht_item_t *ht_handle_item_new(ht_handle_t *table, const char *key,
+                                     size_t length, unsigned int hash,
+                                     float value) {
+  if (length > HT_ITEM_MAX_KEY) {
+    return NULL;
+  }
+  if (table->allocator.alloc == NULL) {
+    return ht_item_new(key, length, hash, value);
+  }
+  void *block =
+      table->allocator.alloc(table->allocator.context, ht_item_size(length));
+  if (block == NULL) {
+    return NULL;
+  }
+  return ht_item_init(block, key, length, hash, value);
+}
+
+/*
+ * Uvolnění prvku vytvořeného ht_handle_item_new.
+ */
+static void ht_handle_item_free(ht_handle_t *table, ht_item_t *item) {
+  if (table->allocator.alloc == NULL) {
+    ht_item_free(item);
+  } else {
+    table->allocator.release(table->allocator.context, item,
+                             ht_item_size(item->key_len));
+  }
+}
+
+/*
+ * Přeuspořádání seznamu v řádku index po nalezení prvku *link podle politiky
+ * tabulky; prev je odkaz na předchůdce (NULL pro první prvek seznamu).
+ * Vrací nalezený prvek. Hledání tak mění tabulku, souběžní čtenáři musí
+ * mít politiku HT_POLICY_NONE.
+ */
+static inline ht_item_t *ht_handle_touch(ht_handle_t *table, size_t index,
+                                         ht_item_t **link, ht_item_t **prev) {
+  ht_item_t *item = *link;
+  if (prev == NULL || table->policy == HT_POLICY_NONE) {
+    return item;
+  }
+  if (table->policy == HT_POLICY_MOVE_TO_FRONT) {
+    *link = item->next;
+    item->next = table->buckets[index];
+    table->buckets[index] = item;
+  } else {
+    ht_item_t *before = *prev;
+    before->next = item->next;
+    item->next = before;
+    *prev = item;
+  }
+  return item;
+}
+
 /*
  * Rozptylovací funkce která přidělí zadanému klíči index z intervalu
  * <0,HT_SIZE-1>. Ideální rozptylovací funkce by měla rozprostírat klíče
  * rovnoměrně po všech indexech. Zamyslete sa nad kvalitou zvolené funkce.
  */
 int get_hash(char *key) {
-  int result = 1;
-  int length = strlen(key);
-  for (int i = 0; i < length; i++) {
-    result += key[i];
+  ht_handle_t view = {.size = (size_t)HT_SIZE, .seed = HT_HASH_SEED};
+  return (int)ht_handle_index(&view, ht_full_hash(&view, key, strlen(key)));
+}
+
+/*
+ * Inicializace tabulky s vlastním nastavením config (NULL pro výchozí).
+ *
+ * Velikost může být libovolná: pro mocninu dvojky se index počítá
+ * násobením a posunem, pro ostatní velikosti se předpočítá převrácená
+ * hodnota pro modulo bez dělení. Alokátor se používá pro prvky, pole
+ * seznamů synonym se alokuje pomocí calloc. Vrací false, pokud se pole
+ * nepodařilo alokovat.
+ */
+bool ht_handle_init(ht_handle_t *table, const ht_handle_config_t *config) {
+  ht_handle_config_t defaults = {0};
+  if (config == NULL) {
+    config = &defaults;
+  }
+  size_t size = config->size != 0 ? config->size : MAX_HT_SIZE;
+  *table = (ht_handle_t){.size = size,
+                         .seed = config->seed,
+                         .hash = config->hash,
+                         .allocator = config->allocator,
+                         .policy = config->policy};
+  if (size >= 2 && (size & (size - 1)) == 0) {
+    unsigned int bits = 0;
+    while (((size_t)1 << bits) < size) {
+      bits++;
+    }
+    table->shift = 64 - bits;
+  } else if (size >= 2 && size <= UINT32_MAX) {
+    table->fastmod = UINT64_MAX / size + 1;
   }
-  return (result % HT_SIZE);
+  table->buckets = calloc(size, sizeof(ht_item_t *));
+  if (table->buckets == NULL) {
+    table->size = 0;
+    return false;
+  }
+  return true;
 }
 
 /*
@@ -38,6 +190,54 @@ void ht_init(ht_table_t *table) {
     }
 }
 
+/*
+ * Vyhledání prvku s klíčem key délky length v tabulce table.
+ *
+ * Klíč nemusí být ukončený nulou (např. úsek namapovaného souboru). Délka
+ * se porovná dřív než bajty klíče, takže seznam synonym se projde bez
+ * jediného strlen. Výsledek je stejný jako u ht_search. Nalezený prvek
+ * se přesune podle politiky tabulky (viz ht_handle_touch); hromadné
+ * vyhledávání ht_handle_search_batch seznamy nemění.
+ */
+ht_item_t *ht_handle_search_n(ht_handle_t *table, const char *key,
+                              size_t length) {
+    // No item can hold a key longer than key_len allows
+    if (length > HT_ITEM_MAX_KEY) {
+        return NULL;
+    }
+    // Calculate the full hash and the hash index for the key
+    unsigned int hash = ht_full_hash(table, key, length);
+    size_t index = ht_handle_index(table, hash);
+    // Traverse the LL at the calculated index, keeping the links to the item
+    // and to its predecessor for the reordering policy
+    ht_item_t **prev = NULL;
+    for (ht_item_t **link = &table->buckets[index]; *link != NULL;
+         link = &(*link)->next) {
+        // Compare the cached hash and length first, the key bytes only on a match
+        if (ht_item_matches(*link, hash, key, length)) {
+            return ht_handle_touch(table, index, link, prev);
+        }
+        prev = link;
+    }
+   // Return NULL, because we haven't found it
+    return NULL;
+}
+
+/*
+ * Vyhledání prvku v tabulce table, viz ht_search.
+ */
+ht_item_t *ht_handle_search(ht_handle_t *table, char *key) {
+    return ht_handle_search_n(table, key, strlen(key));
+}
+
+/*
+ * Vyhledání prvku s klíčem délky length, viz ht_handle_search_n.
+ */
+ht_item_t *ht_search_n(ht_table_t *table, const char *key, size_t length) {
+    ht_handle_t view = ht_table_view(table);
+    return ht_handle_search_n(&view, key, length);
+}
+
 /*
  * Vyhledání prvku v tabulce.
  *
@@ -45,19 +245,101 @@ void ht_init(ht_table_t *table) {
  * hodnotu NULL.
  */
 ht_item_t *ht_search(ht_table_t *table, char *key) {
-    // Calculate the hash index for the key
-    int index = get_hash(key);
-    // Traverse the LL at the calculated index
-    ht_item_t *item = (*table)[index];
-    while (item != NULL) {
-         // If the current item's key matches the search key, then we found it
-        if (strcmp(item->key, key) == 0) {
-            return item;  
+    return ht_search_n(table, key, strlen(key));
+}
+
+/*
+ * Vložení nebo nalezení prvku s klíčem key délky length v tabulce table,
+ * viz ht_upsert. Klíč nemusí být ukončený nulou, nový prvek dostane kopii
+ * ukončenou nulou. Klíč delší než HT_ITEM_MAX_KEY se nevloží (vrací NULL).
+ */
+float *ht_handle_upsert_n(ht_handle_t *table, const char *key, size_t length,
+                          float value) {
+    if (length > HT_ITEM_MAX_KEY) {
+        return NULL;
+    }
+    unsigned int hash = ht_full_hash(table, key, length);
+    size_t index = ht_handle_index(table, hash);
+
+    // Walk the LL once, return the existing value slot if the key is there
+    ht_item_t **prev = NULL;
+    for (ht_item_t **link = &table->buckets[index]; *link != NULL;
+         link = &(*link)->next) {
+        if (ht_item_matches(*link, hash, key, length)) {
+            return &ht_handle_touch(table, index, link, prev)->value;
         }
-        item = item->next;
+        prev = link;
     }
-   // Return NULL, because we haven't found it
-    return NULL;
+
+    // Create a new item, if the existing key wasn't found
+    ht_item_t *newItem = ht_handle_item_new(table, key, length, hash, value);
+    if (newItem == NULL) {
+        // Handle memory allocation error
+        return NULL;
+    }
+
+    // Insert the item at the beginning of the LL
+    newItem->next = table->buckets[index];
+    table->buckets[index] = newItem;
+    return &newItem->value;
+}
+
+/*
+ * Vložení nebo nalezení prvku v tabulce table, viz ht_upsert.
+ */
+float *ht_handle_upsert(ht_handle_t *table, char *key, float value) {
+    return ht_handle_upsert_n(table, key, strlen(key), value);
+}
+
+/*
+ * Vložení nebo nalezení prvku s klíčem délky length, viz
+ * ht_handle_upsert_n.
+ */
+float *ht_upsert_n(ht_table_t *table, const char *key, size_t length,
+                   float value) {
+    ht_handle_t view = ht_table_view(table);
+    return ht_handle_upsert_n(&view, key, length, value);
+}
+
+/*
+ * Vložení nebo nalezení prvku jedním průchodem seznamem synonym.
+ *
+ * Pokud prvek s daným klíčem v tabulce existuje, vrací ukazatel na jeho
+ * hodnotu a hodnotu nemění. V opačném případě vloží na začátek seznamu nový
+ * prvek s hodnotou value a vrací ukazatel na jeho hodnotu. Klíč se hashuje
+ * jen jednou a volající může hodnotu rovnou upravit (např. počítat výskyty).
+ * Při nedostatku paměti vrací NULL.
+ */
+float *ht_upsert(ht_table_t *table, char *key, float value) {
+    return ht_upsert_n(table, key, strlen(key), value);
+}
+
+/*
+ * Vložení prvku s klíčem key délky length do tabulky table, viz ht_insert.
+ */
+void ht_handle_insert_n(ht_handle_t *table, const char *key, size_t length,
+                        float value) {
+    float *slot = ht_handle_upsert_n(table, key, length, value);
+    if (slot != NULL) {
+        // Replace the value of an existing item (a new item already has it)
+        *slot = value;
+    }
+}
+
+/*
+ * Vložení nového prvku do tabulky table, viz ht_insert.
+ */
+void ht_handle_insert(ht_handle_t *table, char *key, float value) {
+    ht_handle_insert_n(table, key, strlen(key), value);
+}
+
+/*
+ * Vložení prvku s klíčem délky length, viz ht_handle_insert_n.
+ */
+void ht_insert_n(ht_table_t *table, const char *key, size_t length,
+                 float value) {
+    ht_handle_t view = ht_table_view(table);
+    ht_handle_insert_n(&view, key, length, value);
 }
 
 /*
@@ -65,43 +347,111 @@ ht_item_t *ht_search(ht_table_t *table, char *key) {
  *
  * Pokud prvek s daným klíčem už v tabulce existuje, nahraďte jeho hodnotu.
  *
- * Při implementaci využijte funkci ht_search. Pri vkládání prvku do seznamu
- * synonym zvolte nejefektivnější možnost a vložte prvek na začátek seznamu.
+ * Vyhledání i vložení proběhne jedním průchodem seznamem ve funkci ht_upsert.
+ * Pri vkládání prvku do seznamu synonym zvolte nejefektivnější možnost
+ * a vložte prvek na začátek seznamu.
  */
 void ht_insert(ht_table_t *table, char *key, float value) {
-    int index = get_hash(key);
+    ht_insert_n(table, key, strlen(key), value);
+}
 
-    // Check if key already exists
-    ht_item_t *existingItem = ht_search(table, key);
-    if (existingItem != NULL) {
-        // If it does, then update the value of the existing item and return
-        existingItem->value = value;
-        return;
+/*
+ * Přičtení delta k hodnotě prvku s klíčem key délky length v tabulce
+ * table, viz ht_add.
+ */
+float *ht_handle_add_n(ht_handle_t *table, const char *key, size_t length,
+                       float delta) {
+    float *slot = ht_handle_upsert_n(table, key, length, 0.0);
+    if (slot != NULL) {
+        *slot += delta;
     }
+    return slot;
+}
 
-    // Create a new item, if the existing key wasn't found in the previous step
-    ht_item_t *newItem = malloc(sizeof(ht_item_t));
-    if (newItem == NULL) {
-        // Handle memory allocation error
-        return;
-    }
+/*
+ * Přičtení delta k hodnotě prvku v tabulce table, viz ht_add.
+ */
+float *ht_handle_add(ht_handle_t *table, char *key, float delta) {
+    return ht_handle_add_n(table, key, strlen(key), delta);
+}
 
-    // Allocate memory for the key
-    newItem->key = malloc(strlen(key) + 1); // +1 for the null terminator
-    if (newItem->key == NULL) {
-        // Handle memory allocation error, free item we created in previous step
-        free(newItem);
-        return;
+/*
+ * Přičtení delta k hodnotě prvku s klíčem délky length, viz
+ * ht_handle_add_n.
+ */
+float *ht_add_n(ht_table_t *table, const char *key, size_t length,
+                float delta) {
+    ht_handle_t view = ht_table_view(table);
+    return ht_handle_add_n(&view, key, length, delta);
+}
+
+/*
+ * Přičtení delta k hodnotě prvku jedním průchodem seznamem synonym.
+ *
+ * Chybějící prvek se vloží s hodnotou delta. Vrací ukazatel na novou
+ * hodnotu, při nedostatku paměti NULL.
+ */
+float *ht_add(ht_table_t *table, char *key, float delta) {
+    return ht_add_n(table, key, strlen(key), delta);
+}
+
+/*
+ * Zvýšení hodnoty prvku v tabulce table o jedna, viz ht_add.
+ */
+float *ht_handle_increment(ht_handle_t *table, char *key) {
+    return ht_handle_add(table, key, 1.0);
+}
+
+/*
+ * Zvýšení hodnoty prvku s klíčem key délky length o jedna, viz ht_add.
+ */
+float *ht_handle_increment_n(ht_handle_t *table, const char *key,
+                             size_t length) {
+    return ht_handle_add_n(table, key, length, 1.0);
+}
+
+/*
+ * Zvýšení hodnoty prvku o jedna (počítání výskytů), viz ht_add.
+ */
+float *ht_increment(ht_table_t *table, char *key) {
+    return ht_add(table, key, 1.0);
+}
+
+/*
+ * Zvýšení hodnoty prvku s klíčem délky length o jedna, viz ht_add.
+ */
+float *ht_increment_n(ht_table_t *table, const char *key, size_t length) {
+    return ht_add_n(table, key, length, 1.0);
+}
+
+/*
+ * Získání hodnoty prvku s klíčem key délky length z tabulky table, viz
+ * ht_get.
+ */
+float *ht_handle_get_n(ht_handle_t *table, const char *key, size_t length) {
+    // Search for the item with the specified key
+    ht_item_t *item = ht_handle_search_n(table, key, length);
+    if (item == NULL) {
+         // If item wasn't found -> return NULL
+        return NULL;
     }
-    // Copy the key into new item
-    strcpy(newItem->key, key);
+    // Return a pointer to the item value
+    return &item->value;
+}
 
-    // Set the value for the new item
-    newItem->value = value;
+/*
+ * Získání hodnoty z tabulky table, viz ht_get.
+ */
+float *ht_handle_get(ht_handle_t *table, char *key) {
+    return ht_handle_get_n(table, key, strlen(key));
+}
 
-    // Insert the item at the beginning of the LL
-    newItem->next = (*table)[index];
-    (*table)[index] = newItem;
+/*
+ * Získání hodnoty prvku s klíčem délky length, viz ht_handle_get_n.
+ */
+float *ht_get_n(ht_table_t *table, const char *key, size_t length) {
+    ht_handle_t view = ht_table_view(table);
+    return ht_handle_get_n(&view, key, length);
 }
 
 /*
@@ -113,41 +463,105 @@ void ht_insert(ht_table_t *table, char *key, float value) {
  * Při implementaci využijte funkci ht_search.
  */
 float *ht_get(ht_table_t *table, char *key) {
-    // Search for the item with the specified key
-    ht_item_t *item = ht_search(table, key);
-    if (item == NULL) {
-         // If item wasn't found -> return NULL
-        return NULL;
+    return ht_get_n(table, key, strlen(key));
+}
+
+/*
+ * Vyhledání skupiny nejvýše HT_ITEM_BATCH klíčů, viz ht_search_batch.
+ */
+static void ht_search_group(ht_handle_t *table, char **keys, size_t count,
+                            ht_item_t **items) {
+    unsigned int hashes[HT_ITEM_BATCH];
+    size_t lengths[HT_ITEM_BATCH];
+    ht_item_t *cursor[HT_ITEM_BATCH];
+
+    // Hash every key first, then prefetch all chain heads before walking
+    for (size_t i = 0; i < count; i++) {
+        lengths[i] = strlen(keys[i]);
+        hashes[i] = ht_full_hash(table, keys[i], lengths[i]);
+        cursor[i] = table->buckets[ht_handle_index(table, hashes[i])];
+        if (cursor[i] != NULL) {
+            ht_item_prefetch(cursor[i]);
+        }
+        items[i] = NULL;
     }
-    // Return a pointer to the item value
-    return &item->value;
+    ht_item_walk_batch(cursor, keys, hashes, lengths, count, items);
 }
 
 /*
- * Smazání prvku z tabulky.
+ * Vyhledání count klíčů v tabulce table najednou, viz ht_search_batch.
+ */
+void ht_handle_search_batch(ht_handle_t *table, char **keys, size_t count,
+                            ht_item_t **items) {
+    for (size_t i = 0; i < count; i += HT_ITEM_BATCH) {
+        size_t group = count - i < HT_ITEM_BATCH ? count - i : HT_ITEM_BATCH;
+        ht_search_group(table, keys + i, group, items + i);
+    }
+}
+
+/*
+ * Vyhledání count klíčů najednou.
  *
- * Funkce korektně uvolní všechny alokované zdroje přiřazené k danému prvku.
- * Pokud prvek neexistuje, funkce nedělá nic.
+ * Do items[i] zapíše prvek s klíčem keys[i], nebo NULL. Klíče se zpracují
+ * po skupinách: nejdřív se spočítají všechny hashe a přednačtou začátky
+ * seznamů, pak se seznamy procházejí prokládaně, takže čekání na paměť
+ * u různých klíčů se překrývá.
+ */
+void ht_search_batch(ht_table_t *table, char **keys, size_t count,
+                     ht_item_t **items) {
+    ht_handle_t view = ht_table_view(table);
+    ht_handle_search_batch(&view, keys, count, items);
+}
+
+/*
+ * Získání hodnot count klíčů z tabulky table najednou, viz ht_get_batch.
+ */
+void ht_handle_get_batch(ht_handle_t *table, char **keys, size_t count,
+                         float **values) {
+    ht_item_t *items[HT_ITEM_BATCH];
+    for (size_t i = 0; i < count; i += HT_ITEM_BATCH) {
+        size_t group = count - i < HT_ITEM_BATCH ? count - i : HT_ITEM_BATCH;
+        ht_search_group(table, keys + i, group, items);
+        for (size_t j = 0; j < group; j++) {
+            values[i + j] = items[j] != NULL ? &items[j]->value : NULL;
+        }
+    }
+}
+
+/*
+ * Získání hodnot count klíčů najednou.
  *
- * Při implementaci NEPOUŽÍVEJTE funkci ht_search.
+ * Do values[i] zapíše ukazatel na hodnotu prvku s klíčem keys[i], nebo NULL.
  */
-void ht_delete(ht_table_t *table, char *key) {
-    // Calculate the hash index for the key
-    int index = get_hash(key);
+void ht_get_batch(ht_table_t *table, char **keys, size_t count,
+                  float **values) {
+    ht_handle_t view = ht_table_view(table);
+    ht_handle_get_batch(&view, keys, count, values);
+}
+
+/*
+ * Smazání prvku s klíčem key délky length z tabulky table, viz ht_delete.
+ */
+void ht_handle_delete_n(ht_handle_t *table, const char *key, size_t length) {
+    if (length > HT_ITEM_MAX_KEY) {
+        return;
+    }
+    // Calculate the full hash and the hash index for the key
+    unsigned int hash = ht_full_hash(table, key, length);
+    size_t index = ht_handle_index(table, hash);
     // Traverse the LL to find and remove the item
-    ht_item_t *current = (*table)[index];
+    ht_item_t *current = table->buckets[index];
     ht_item_t *previous = NULL;
     while (current != NULL) {
-        if (strcmp(current->key, key) == 0) {
+        if (ht_item_matches(current, hash, key, length)) {
             // If the item is found, remove it from the LL and free its memory
             if (previous == NULL) {
-                (*table)[index] = current->next;
+                table->buckets[index] = current->next;
             } else {
                 // Link previous next to the current next, so we take out the item out of the LL
                 previous->next = current->next;
             }
-            free(current->key);
-            free(current);
+            ht_handle_item_free(table, current);
             return;
         }
         previous = current;
@@ -156,23 +570,268 @@ void ht_delete(ht_table_t *table, char *key) {
 }
 
 /*
- * Smazání všech prvků z tabulky.
+ * Smazání prvku z tabulky table, viz ht_delete.
+ */
+void ht_handle_delete(ht_handle_t *table, char *key) {
+    ht_handle_delete_n(table, key, strlen(key));
+}
+
+/*
+ * Smazání prvku s klíčem délky length, viz ht_handle_delete_n.
+ */
+void ht_delete_n(ht_table_t *table, const char *key, size_t length) {
+    ht_handle_t view = ht_table_view(table);
+    ht_handle_delete_n(&view, key, length);
+}
+
+/*
+ * Smazání prvku z tabulky.
  *
- * Funkce korektně uvolní všechny alokované zdroje a uvede tabulku do stavu po 
- * inicializaci.
+ * Funkce korektně uvolní všechny alokované zdroje přiřazené k danému prvku.
+ * Pokud prvek neexistuje, funkce nedělá nic.
+ *
+ * Při implementaci NEPOUŽÍVEJTE funkci ht_search.
  */
-void ht_delete_all(ht_table_t *table) {
+void ht_delete(ht_table_t *table, char *key) {
+    ht_delete_n(table, key, strlen(key));
+}
+
+// Klíč dávky ht_insert_many / ht_delete_many
+typedef struct ht_batch_entry {
+  char *key;           // klíč
+  float value;         // vkládaná hodnota (jen ht_insert_many)
+  unsigned int hash;   // celý hash klíče
+  size_t length;       // délka klíče
+  ht_item_t *item;     // prvek tabulky s tímto klíčem, pokud je znám
+} ht_batch_entry_t;
+
+/*
+ * Spočítá hashe klíčů dávky a stabilně je seřadí podle řádku tabulky
+ * (řazení počítáním). Do order zapíše indexy klíčů po řádcích, klíče
+ * řádku r leží v order na pozicích <first[r], first[r+1]); pole first má
+ * table->size + 1 položek.
+ */
+static void ht_batch_prepare(ht_handle_t *table, ht_batch_entry_t *batch,
+                             int count, int *order, int *first) {
+    for (size_t r = 0; r <= table->size; r++) {
+        first[r] = 0;
+    }
+    for (int i = 0; i < count; i++) {
+        batch[i].length = strlen(batch[i].key);
+        batch[i].hash = ht_full_hash(table, batch[i].key, batch[i].length);
+        batch[i].item = NULL;
+        first[ht_handle_index(table, batch[i].hash) + 1]++;
+    }
+    for (size_t r = 0; r < table->size; r++) {
+        first[r + 1] += first[r];
+    }
+    // first[r] runs to the end of row r while placing, shift it back after
+    for (int i = 0; i < count; i++) {
+        order[first[ht_handle_index(table, batch[i].hash)]++] = i;
+    }
+    for (size_t r = table->size; r > 0; r--) {
+        first[r] = first[r - 1];
+    }
+    first[0] = 0;
+}
+
+/*
+ * Přeuspořádání řádku r po nalezení prvku item, který v řádku leží, stejně
+ * jako v ht_handle_upsert_n (viz ht_handle_touch). Řádek se kvůli odkazu na
+ * předchůdce projde od začátku, volá se proto jen s politikou tabulky.
+ */
+static void ht_batch_touch(ht_handle_t *table, size_t r, ht_item_t *item) {
+    ht_item_t **prev = NULL;
+    ht_item_t **link = &table->buckets[r];
+    while (*link != item) {
+        prev = link;
+        link = &(*link)->next;
+    }
+    ht_handle_touch(table, r, link, prev);
+}
+
+/*
+ * Vložení count prvků do tabulky table najednou, viz ht_insert_many.
+ *
+ * Dávka prochází všechny řádky tabulky, vyplatí se proto pro dávky
+ * srovnatelné s velikostí tabulky nebo větší.
+ */
+void ht_handle_insert_many(ht_handle_t *table, const ht_item_t items[],
+                           int count) {
+    ht_batch_entry_t *batch = malloc(count * sizeof(ht_batch_entry_t));
+    int *order = malloc(count * sizeof(int));
+    int *first = malloc((table->size + 1) * sizeof(int));
+    if (batch == NULL || order == NULL || first == NULL) {
+        // Without memory for the batch fall back to inserting one by one
+        free(batch);
+        free(order);
+        free(first);
+        for (int i = 0; i < count; i++) {
+            ht_handle_insert(table, items[i].key, items[i].value);
+        }
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        batch[i].key = items[i].key;
+        batch[i].value = items[i].value;
+    }
+    ht_batch_prepare(table, batch, count, order, first);
+
+    for (size_t r = 0; r < table->size; r++) {
+        // One walk of the chain finds every batch key that is already there
+        for (ht_item_t *item = table->buckets[r];
+             item != NULL && first[r] < first[r + 1]; item = item->next) {
+            for (int k = first[r]; k < first[r + 1]; k++) {
+                ht_batch_entry_t *entry = &batch[order[k]];
+                if (entry->item == NULL &&
+                    ht_item_matches(item, entry->hash, entry->key,
+                                    entry->length)) {
+                    entry->item = item;
+                }
+            }
+        }
+
+        // Apply the keys in batch order, new ones at the head of the chain
+        for (int k = first[r]; k < first[r + 1]; k++) {
+            ht_batch_entry_t *entry = &batch[order[k]];
+            if (entry->item == NULL) {
+                entry->item = ht_handle_item_new(table, entry->key,
+                                                 entry->length, entry->hash,
+                                                 entry->value);
+                if (entry->item == NULL) {
+                    continue;
+                }
+                entry->item->next = table->buckets[r];
+                table->buckets[r] = entry->item;
+                // Later occurrences of the same key update the new item
+                for (int j = k + 1; j < first[r + 1]; j++) {
+                    ht_batch_entry_t *later = &batch[order[j]];
+                    if (later->item == NULL &&
+                        ht_item_matches(entry->item, later->hash, later->key,
+                                        later->length)) {
+                        later->item = entry->item;
+                    }
+                }
+            } else if (table->policy != HT_POLICY_NONE) {
+                // An existing key moves like it would in ht_handle_upsert_n
+                ht_batch_touch(table, r, entry->item);
+            }
+            entry->item->value = entry->value;
+        }
+    }
+    free(first);
+    free(order);
+    free(batch);
+}
+
+/*
+ * Vložení count prvků najednou.
+ *
+ * Výsledek je stejný jako při volání ht_insert pro každý prvek v pořadí
+ * pole (včetně pořadí v seznamech synonym a opakovaných klíčů, i s politikou
+ * HT_TABLE_POLICY), ale klíče se nejdřív zahashují a seskupí podle řádku
+ * a každý seznam synonym se projde jen jednou pro všechny klíče svého
+ * řádku. S politikou přeuspořádání se řádek navíc projde pro každý klíč,
+ * který v tabulce už je.
+ */
+void ht_insert_many(ht_table_t *table, const ht_item_t items[], int count) {
+    ht_handle_t view = ht_table_view(table);
+    ht_handle_insert_many(&view, items, count);
+}
+
+/*
+ * Smazání count klíčů z tabulky table najednou, viz ht_delete_many.
+ */
+void ht_handle_delete_many(ht_handle_t *table, char *keys[], int count) {
+    ht_batch_entry_t *batch = malloc(count * sizeof(ht_batch_entry_t));
+    int *order = malloc(count * sizeof(int));
+    int *first = malloc((table->size + 1) * sizeof(int));
+    if (batch == NULL || order == NULL || first == NULL) {
+        free(batch);
+        free(order);
+        free(first);
+        for (int i = 0; i < count; i++) {
+            ht_handle_delete(table, keys[i]);
+        }
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        batch[i].key = keys[i];
+    }
+    ht_batch_prepare(table, batch, count, order, first);
+
+    for (size_t r = 0; r < table->size; r++) {
+        ht_item_t **link = &table->buckets[r];
+        while (*link != NULL && first[r] < first[r + 1]) {
+            ht_item_t *item = *link;
+            bool doomed = false;
+            for (int k = first[r]; k < first[r + 1] && !doomed; k++) {
+                ht_batch_entry_t *entry = &batch[order[k]];
+                doomed = ht_item_matches(item, entry->hash, entry->key,
+                                         entry->length);
+            }
+            if (doomed) {
+                *link = item->next;
+                ht_handle_item_free(table, item);
+            } else {
+                link = &item->next;
+            }
+        }
+    }
+    free(first);
+    free(order);
+    free(batch);
+}
+
+/*
+ * Smazání count klíčů najednou.
+ *
+ * Výsledek je stejný jako při volání ht_delete pro každý klíč, ale klíče se
+ * seskupí podle řádku a každý seznam synonym se projde jen jednou.
+ * Neexistující klíče se přeskočí.
+ */
+void ht_delete_many(ht_table_t *table, char *keys[], int count) {
+    ht_handle_t view = ht_table_view(table);
+    ht_handle_delete_many(&view, keys, count);
+}
+
+/*
+ * Smazání všech prvků z tabulky table, viz ht_delete_all. Pole seznamů
+ * synonym si tabulka ponechá.
+ */
+void ht_handle_delete_all(ht_handle_t *table) {
     // Traverse the entire table to remove all items
-    for (int i = 0; i < HT_SIZE; i++) {
-        ht_item_t *item = (*table)[i];
+    for (size_t i = 0; i < table->size; i++) {
+        ht_item_t *item = table->buckets[i];
         while (item != NULL) {
             // Free each item and its key
             ht_item_t *nextItem = item->next;
-            free(item->key);
-            free(item);
+            ht_handle_item_free(table, item);
             item = nextItem;
         }
         // Set the table slot to NULL after clearing it
-        (*table)[i] = NULL;
+        table->buckets[i] = NULL;
     }
 }
+
+/*
+ * Smazání všech prvků z tabulky.
+ *
+ * Funkce korektně uvolní všechny alokované zdroje a uvede tabulku do stavu po 
+ * inicializaci.
+ */
+void ht_delete_all(ht_table_t *table) {
+    ht_handle_t view = ht_table_view(table);
+    ht_handle_delete_all(&view);
+}
+
+/*
+ * Zrušení tabulky z ht_handle_init — uvolní všechny prvky i pole seznamů
+ * synonym.
+ */
+void ht_handle_destroy(ht_handle_t *table) {
+    ht_handle_delete_all(table);
+    free(table->buckets);
+    table->buckets = NULL;
+    table->size = 0;
+}
@@ -6,7 +6,10 @@
 #ifndef IAL_HASHTABLE_H
 #define IAL_HASHTABLE_H
 
+#include "ht_hash.h"
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 /*
  * Maximálna veľkosť poľa pre implementáciu tabuľky.
@@ -26,17 +29,112 @@ typedef struct ht_item {
   char *key;            // kľúč prvku
   float value;          // hodnota prvku
   struct ht_item *next; // ukazateľ na ďalšie synonymum
+  unsigned int hash;    // celý hash kľúča (pred výpočtom indexu)
+  unsigned int key_len; // dĺžka kľúča bez ukončovacej nuly
 } ht_item_t;
 
 // Tabuľka o reálnej veľkosti MAX_HT_SIZE
 typedef ht_item_t *ht_table_t[MAX_HT_SIZE];
 
+// Alokátor prvků tabulky ht_handle_t (alloc == NULL znamená malloc/free)
+typedef struct ht_allocator {
+  void *(*alloc)(void *context, size_t size);               // nový blok
+  void (*release)(void *context, void *block, size_t size); // vrácení bloku
+  void *context;                                            // stav alokátoru
+} ht_allocator_t;
+
+// Přeuspořádání seznamu synonym po nalezení klíče (samoorganizující seznamy)
+typedef enum ht_policy {
+  HT_POLICY_NONE,          // seznam se při hledání nemění
+  HT_POLICY_MOVE_TO_FRONT, // nalezený prvek se přesune na začátek seznamu
+  HT_POLICY_TRANSPOSE      // nalezený prvek se prohodí se svým předchůdcem
+} ht_policy_t;
+
+/*
+ * Politika pro tabulky ht_table_t, volí se při překladu
+ * (-DHT_TABLE_POLICY=HT_POLICY_MOVE_TO_FRONT). Výchozí HT_POLICY_NONE
+ * zachovává pořadí seznamů, na kterém stojí výstup test.c.
+ */
+#ifndef HT_TABLE_POLICY
+#define HT_TABLE_POLICY HT_POLICY_NONE
+#endif
+
+// Nastavení tabulky ht_handle_t, nulové položky znamenají výchozí hodnotu
+typedef struct ht_handle_config {
+  size_t size;              // počet řádků, 0 pro MAX_HT_SIZE
+  uint64_t seed;            // semínko rozptylovací funkce
+  ht_hash_fn_t hash;        // rozptylovací funkce, NULL pro tu z get_hash
+  ht_allocator_t allocator; // alokátor prvků
+  ht_policy_t policy;       // přeuspořádání seznamu při nalezení klíče
+} ht_handle_config_t;
+
+// Tabulka s vlastní velikostí, rozptylovací funkcí a alokátorem
+typedef struct ht_handle {
+  ht_item_t **buckets;      // pole seznamů synonym
+  size_t size;              // počet řádků
+  unsigned int shift;       // 64 - k pro size = 2^k, jinak 0
+  uint64_t fastmod;         // 2^64 / size zaokrouhleno nahoru, 0 pro %
+  uint64_t seed;            // semínko rozptylovací funkce
+  ht_hash_fn_t hash;        // rozptylovací funkce, NULL pro tu z get_hash
+  ht_allocator_t allocator; // alokátor prvků
+  ht_policy_t policy;       // přeuspořádání seznamu při nalezení klíče
+} ht_handle_t;
+
 int get_hash(char *key);
 void ht_init(ht_table_t *table);
 ht_item_t *ht_search(ht_table_t *table, char *key);
 void ht_insert(ht_table_t *table, char *key, float data);
+float *ht_upsert(ht_table_t *table, char *key, float data);
+float *ht_add(ht_table_t *table, char *key, float delta);
+float *ht_increment(ht_table_t *table, char *key);
 float *ht_get(ht_table_t *table, char *key);
+void ht_search_batch(ht_table_t *table, char **keys, size_t count,
+                     ht_item_t **items);
+void ht_get_batch(ht_table_t *table, char **keys, size_t count,
+                  float **values);
 void ht_delete(ht_table_t *table, char *key);
+void ht_insert_many(ht_table_t *table, const ht_item_t items[], int count);
+void ht_delete_many(ht_table_t *table, char *keys[], int count);
 void ht_delete_all(ht_table_t *table);
+ht_item_t *ht_search_n(ht_table_t *table, const char *key, size_t length);
+void ht_insert_n(ht_table_t *table, const char *key, size_t length,
+                 float value);
+float *ht_upsert_n(ht_table_t *table, const char *key, size_t length,
+                   float value);
+float *ht_add_n(ht_table_t *table, const char *key, size_t length,
+                float delta);
+float *ht_increment_n(ht_table_t *table, const char *key, size_t length);
+float *ht_get_n(ht_table_t *table, const char *key, size_t length);
+void ht_delete_n(ht_table_t *table, const char *key, size_t length);
+
+bool ht_handle_init(ht_handle_t *table, const ht_handle_config_t *config);
+ht_item_t *ht_handle_search(ht_handle_t *table, char *key);
+void ht_handle_insert(ht_handle_t *table, char *key, float value);
+float *ht_handle_upsert(ht_handle_t *table, char *key, float value);
+float *ht_handle_add(ht_handle_t *table, char *key, float delta);
+float *ht_handle_increment(ht_handle_t *table, char *key);
+float *ht_handle_get(ht_handle_t *table, char *key);
+void ht_handle_search_batch(ht_handle_t *table, char **keys, size_t count,
+                            ht_item_t **items);
+void ht_handle_get_batch(ht_handle_t *table, char **keys, size_t count,
+                         float **values);
+void ht_handle_delete(ht_handle_t *table, char *key);
+void ht_handle_insert_many(ht_handle_t *table, const ht_item_t items[],
+                           int count);
+void ht_handle_delete_many(ht_handle_t *table, char *keys[], int count);
+void ht_handle_delete_all(ht_handle_t *table);
+void ht_handle_destroy(ht_handle_t *table);
+ht_item_t *ht_handle_search_n(ht_handle_t *table, const char *key,
+                              size_t length);
+void ht_handle_insert_n(ht_handle_t *table, const char *key, size_t length,
+                        float value);
+float *ht_handle_upsert_n(ht_handle_t *table, const char *key, size_t length,
+                          float value);
+float *ht_handle_add_n(ht_handle_t *table, const char *key, size_t length,
+                       float delta);
+float *ht_handle_increment_n(ht_handle_t *table, const char *key,
+                             size_t length);
+float *ht_handle_get_n(ht_handle_t *table, const char *key, size_t length);
+void ht_handle_delete_n(ht_handle_t *table, const char *key, size_t length);
 
 #endif
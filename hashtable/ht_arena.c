@@ -0,0 +1,157 @@
+/*
+ * Arénový alokátor prvků tabulky
+ *
+ * Bloky se alokují jednou a při ht_arena_reset se jen přesune ukazatel zpět
+ * na začátek prvního bloku, takže smazání všech prvků tabulky nestojí ani
+ * jedno volání free na prvek.
+ */
+
+#include "ht_arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Zaokrouhlení velikosti nahoru na násobek HT_ARENA_ALIGN.
+ */
+static size_t ht_arena_round(size_t size) {
+    if (size < sizeof(ht_arena_free_t)) {
+        size = sizeof(ht_arena_free_t);
+    }
+    return (size + HT_ARENA_ALIGN - 1) / HT_ARENA_ALIGN * HT_ARENA_ALIGN;
+}
+
+/*
+ * Inicializace prázdné arény. Žádná paměť se zatím nealokuje.
+ */
+void ht_arena_init(ht_arena_t *arena) {
+    arena->blocks = NULL;
+    arena->current = NULL;
+    arena->large = NULL;
+    arena->used = 0;
+    memset(arena->free_lists, 0, sizeof(arena->free_lists));
+}
+
+/*
+ * Přidělení úseku alespoň size bajtů zarovnaného na HT_ARENA_ALIGN.
+ *
+ * Nejprve se použije volný úsek stejné třídy, pak zbytek aktuálního bloku,
+ * pak další ponechaný blok a teprve nakonec se alokuje nový blok.
+ * Při nedostatku paměti vrací NULL.
+ */
+void *ht_arena_alloc(ht_arena_t *arena, size_t size) {
+    size = ht_arena_round(size);
+    size_t class = size / HT_ARENA_ALIGN;
+
+    if (class >= HT_ARENA_CLASSES) {
+        // Large chunks get their own block, they are rare for word keys
+        ht_arena_block_t *block = malloc(sizeof(ht_arena_block_t) + size);
+        if (block == NULL) {
+            return NULL;
+        }
+        block->size = size;
+        block->next = arena->large;
+        arena->large = block;
+        return block->data;
+    }
+
+    // Reuse a chunk released by ht_arena_release
+    ht_arena_free_t *chunk = arena->free_lists[class];
+    if (chunk != NULL) {
+        arena->free_lists[class] = chunk->next;
+        return chunk;
+    }
+
+    // Move on to the next retained block or allocate a new one
+    if (arena->current == NULL || arena->used + size > arena->current->size) {
+        ht_arena_block_t *next =
+            arena->current != NULL ? arena->current->next : arena->blocks;
+        if (next == NULL) {
+            next = malloc(sizeof(ht_arena_block_t) + HT_ARENA_BLOCK_SIZE);
+            if (next == NULL) {
+                return NULL;
+            }
+            next->size = HT_ARENA_BLOCK_SIZE;
+            next->next = NULL;
+            if (arena->current != NULL) {
+                arena->current->next = next;
+            } else {
+                arena->blocks = next;
+            }
+        }
+        arena->current = next;
+        arena->used = 0;
+    }
+
+    void *ptr = arena->current->data + arena->used;
+    arena->used += size;
+    return ptr;
+}
+
+/*
+ * Vrácení úseku velikosti size (stejné jako při alokaci) do arény.
+ *
+ * Úsek se zařadí do seznamu volných úseků své třídy. Velké úseky se uvolní
+ * až při ht_arena_reset nebo ht_arena_destroy.
+ */
+void ht_arena_release(ht_arena_t *arena, void *ptr, size_t size) {
+    size_t class = ht_arena_round(size) / HT_ARENA_ALIGN;
+    if (ptr == NULL || class >= HT_ARENA_CLASSES) {
+        return;
+    }
+    ht_arena_free_t *chunk = ptr;
+    chunk->next = arena->free_lists[class];
+    arena->free_lists[class] = chunk;
+}
+
+/*
+ * Uvolnění seznamu bloků.
+ */
+static void ht_arena_free_blocks(ht_arena_block_t *block) {
+    while (block != NULL) {
+        ht_arena_block_t *next = block->next;
+        free(block);
+        block = next;
+    }
+}
+
+/*
+ * Vyprázdnění arény — všechny přidělené úseky přestanou být platné.
+ *
+ * Běžné bloky zůstávají alokované a další přidělování začne znovu od prvního
+ * z nich, takže cena nezávisí na počtu přidělených úseků.
+ */
+void ht_arena_reset(ht_arena_t *arena) {
+    ht_arena_free_blocks(arena->large);
+    arena->large = NULL;
+    arena->current = arena->blocks;
+    arena->used = 0;
+    memset(arena->free_lists, 0, sizeof(arena->free_lists));
+}
+
+/*
+ * Zrušení arény — uvolní všechny bloky.
+ */
+void ht_arena_destroy(ht_arena_t *arena) {
+    ht_arena_free_blocks(arena->blocks);
+    ht_arena_free_blocks(arena->large);
+    ht_arena_init(arena);
+}
+
+static void *ht_arena_allocator_alloc(void *context, size_t size) {
+    return ht_arena_alloc(context, size);
+}
+
+static void ht_arena_allocator_release(void *context, void *block,
+                                       size_t size) {
+    ht_arena_release(context, block, size);
+}
+
+/*
+ * Alokátor pro ht_handle_config_t, který přiděluje prvky z arény arena.
+ * Aréna musí žít déle než tabulka.
+ */
+ht_allocator_t ht_arena_allocator(ht_arena_t *arena) {
+    return (ht_allocator_t){.alloc = ht_arena_allocator_alloc,
+                            .release = ht_arena_allocator_release,
+                            .context = arena};
+}
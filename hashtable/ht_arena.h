@@ -0,0 +1,54 @@
+/*
+ * Hlavičkový soubor pro arénový alokátor prvků tabulky.
+ *
+ * Paměť se přiděluje postupně z velkých bloků. Uvolněné úseky se vrací do
+ * seznamů volných úseků podle velikostní třídy (násobky HT_ARENA_ALIGN)
+ * a další alokace stejné třídy je použije znovu. Celou arénu lze vyprázdnit
+ * v konstantním čase funkcí ht_arena_reset — bloky si aréna ponechá pro další
+ * plnění.
+ */
+
+#ifndef IAL_HT_ARENA_H
+#define IAL_HT_ARENA_H
+
+#include "hashtable.h"
+#include <stddef.h>
+
+// Zarovnání a granularita přidělovaných úseků
+#define HT_ARENA_ALIGN 16
+
+// Počet velikostních tříd; větší úseky se alokují samostatně
+#define HT_ARENA_CLASSES 64
+
+// Velikost jednoho bloku
+#define HT_ARENA_BLOCK_SIZE (64 * 1024)
+
+// Blok paměti arény
+typedef struct ht_arena_block {
+  struct ht_arena_block *next; // další blok v pořadí alokace
+  size_t size;                 // velikost pole data
+  unsigned char data[];        // přidělovaná paměť
+} ht_arena_block_t;
+
+// Volný úsek v seznamu volných úseků
+typedef struct ht_arena_free {
+  struct ht_arena_free *next;
+} ht_arena_free_t;
+
+// Aréna
+typedef struct ht_arena {
+  ht_arena_block_t *blocks;  // všechny běžné bloky v pořadí alokace
+  ht_arena_block_t *current; // blok, ze kterého se právě přiděluje
+  ht_arena_block_t *large;   // samostatně alokované velké úseky
+  size_t used;               // obsazená část aktuálního bloku
+  ht_arena_free_t *free_lists[HT_ARENA_CLASSES]; // volné úseky podle třídy
+} ht_arena_t;
+
+void ht_arena_init(ht_arena_t *arena);
+void *ht_arena_alloc(ht_arena_t *arena, size_t size);
+void ht_arena_release(ht_arena_t *arena, void *ptr, size_t size);
+void ht_arena_reset(ht_arena_t *arena);
+void ht_arena_destroy(ht_arena_t *arena);
+ht_allocator_t ht_arena_allocator(ht_arena_t *arena);
+
+#endif
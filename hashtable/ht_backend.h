@@ -0,0 +1,147 @@
+/*
+ * Volba implementace tabulky při překladu pro společné testy a benchmarky.
+ *
+ * Makro HT_BACKEND vybere jednu z implementací a namapuje její funkce na
+ * jednotné rozhraní htb_*:
+ *   htb_table_t, htb_entry_t (prvek s položkou key)
+ *   bool htb_init(htb_table_t *table)
+ *   htb_entry_t *htb_search(htb_table_t *table, char *key)
+ *   float htb_value(htb_entry_t *entry)
+ *   void htb_insert(htb_table_t *table, char *key, float value)
+ *   float *htb_get(htb_table_t *table, char *key)
+ *   void htb_delete(htb_table_t *table, char *key)
+ *   void htb_delete_all(htb_table_t *table)
+ *   void htb_destroy(htb_table_t *table)
+ * Například: gcc -DHT_BACKEND=HT_BACKEND_SWISS ...
+ */
+
+#ifndef IAL_HT_BACKEND_H
+#define IAL_HT_BACKEND_H
+
+#include <stdbool.h>
+
+#define HT_BACKEND_CHAIN 0    // ht_table_t, pevná velikost HT_SIZE
+#define HT_BACKEND_MAP 1      // ht_map_t, rostoucí zřetězená tabulka
+#define HT_BACKEND_SWISS 2    // ht_swiss_t, otevřené adresování se skupinami
+#define HT_BACKEND_ROBIN 3    // ht_robin_t, otevřené adresování Robin Hood
+#define HT_BACKEND_CUCKOO 4   // ht_cuckoo_t, kukaččí hashování po řádcích
+#define HT_BACKEND_COMPACT 5  // ht_compact_t, husté pole prvků s indexem
+#define HT_BACKEND_UNROLLED 6 // ht_unrolled_t, seznamy s uzly po řádku cache
+
+#ifndef HT_BACKEND
+#define HT_BACKEND HT_BACKEND_CHAIN
+#endif
+
+#if HT_BACKEND == HT_BACKEND_CHAIN
+
+#include "hashtable.h"
+#define HTB_NAME "chain"
+typedef ht_table_t htb_table_t;
+typedef ht_item_t htb_entry_t;
+static inline bool htb_init(htb_table_t *table) {
+  ht_init(table);
+  return true;
+}
+#define htb_search ht_search
+#define htb_insert ht_insert
+#define htb_get ht_get
+#define htb_delete ht_delete
+#define htb_delete_all ht_delete_all
+#define htb_destroy ht_delete_all
+
+#elif HT_BACKEND == HT_BACKEND_MAP
+
+#include "ht_map.h"
+#define HTB_NAME "map"
+typedef ht_map_t htb_table_t;
+typedef ht_item_t htb_entry_t;
+#define htb_init ht_map_init
+#define htb_search ht_map_search
+#define htb_insert ht_map_insert
+#define htb_get ht_map_get
+#define htb_delete ht_map_delete
+#define htb_delete_all ht_map_delete_all
+#define htb_destroy ht_map_destroy
+
+#elif HT_BACKEND == HT_BACKEND_SWISS
+
+#include "ht_swiss.h"
+#define HTB_NAME "swiss"
+typedef ht_swiss_t htb_table_t;
+typedef ht_swiss_slot_t htb_entry_t;
+#define htb_init ht_swiss_init
+#define htb_search ht_swiss_search
+#define htb_insert ht_swiss_insert
+#define htb_get ht_swiss_get
+#define htb_delete ht_swiss_delete
+#define htb_delete_all ht_swiss_delete_all
+#define htb_destroy ht_swiss_destroy
+
+#elif HT_BACKEND == HT_BACKEND_ROBIN
+
+#include "ht_robin.h"
+#define HTB_NAME "robin"
+typedef ht_robin_t htb_table_t;
+typedef ht_robin_slot_t htb_entry_t;
+#define htb_init ht_robin_init
+#define htb_search ht_robin_search
+#define htb_insert ht_robin_insert
+#define htb_get ht_robin_get
+#define htb_delete ht_robin_delete
+#define htb_delete_all ht_robin_delete_all
+#define htb_destroy ht_robin_destroy
+
+#elif HT_BACKEND == HT_BACKEND_CUCKOO
+
+#include "ht_cuckoo.h"
+#define HTB_NAME "cuckoo"
+typedef ht_cuckoo_t htb_table_t;
+typedef ht_cuckoo_slot_t htb_entry_t;
+#define htb_init ht_cuckoo_init
+#define htb_search ht_cuckoo_search
+#define htb_insert ht_cuckoo_insert
+#define htb_get ht_cuckoo_get
+#define htb_delete ht_cuckoo_delete
+#define htb_delete_all ht_cuckoo_delete_all
+#define htb_destroy ht_cuckoo_destroy
+
+#elif HT_BACKEND == HT_BACKEND_COMPACT
+
+#include "ht_compact.h"
+#define HTB_NAME "compact"
+typedef ht_compact_t htb_table_t;
+typedef ht_compact_entry_t htb_entry_t;
+#define htb_init ht_compact_init
+#define htb_search ht_compact_search
+#define htb_insert ht_compact_insert
+#define htb_get ht_compact_get
+#define htb_delete ht_compact_delete
+#define htb_delete_all ht_compact_delete_all
+#define htb_destroy ht_compact_destroy
+
+#elif HT_BACKEND == HT_BACKEND_UNROLLED
+
+#include "ht_unrolled.h"
+#define HTB_NAME "unrolled"
+typedef ht_unrolled_t htb_table_t;
+typedef ht_unrolled_entry_t htb_entry_t;
+#define htb_init ht_unrolled_init
+// The view into the node lives in the block that calls htb_search
+#define htb_search(table, key)                                                 \
+  ht_unrolled_search((table), (key), &(ht_unrolled_entry_t){NULL, NULL})
+#define htb_value(entry) (*(entry)->value)
+#define htb_insert ht_unrolled_insert
+#define htb_get ht_unrolled_get
+#define htb_delete ht_unrolled_delete
+#define htb_delete_all ht_unrolled_delete_all
+#define htb_destroy ht_unrolled_destroy
+
+#else
+#error "Neznámá hodnota HT_BACKEND"
+#endif
+
+#ifndef htb_value
+#define htb_value(entry) ((entry)->value)
+#endif
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ * Blokový Bloomův filtr
+ *
+ * Rozložení bitů odpovídá "split block" filtru formátu Parquet: 32bitová
+ * část hashe se vynásobí osmi lichými konstantami a horních pět bitů
+ * každého součinu určí bit v jednom slově bloku.
+ */
+
+#include "ht_bloom.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const uint32_t HT_BLOOM_SALT[HT_BLOOM_BLOCK_WORDS] = {
+    0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+    0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+
+/*
+ * Rozmíchání 32bitového hashe prvku na 64 bitů (finalizér splitmix64).
+ * Horní polovina vybírá blok, dolní bity v bloku, aby na sobě nezávisely.
+ */
+static inline uint64_t ht_bloom_mix(unsigned int hash) {
+    uint64_t x = hash + 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/*
+ * Blok pro rozmíchaný hash x (násobení místo modula).
+ */
+static inline size_t ht_bloom_block_index(const ht_bloom_t *bloom, uint64_t x) {
+    return (size_t)(((x >> 32) * bloom->block_count) >> 32);
+}
+
+/*
+ * Inicializace filtru pro capacity klíčů.
+ *
+ * Vrací false, pokud se nepodařilo alokovat bloky.
+ */
+bool ht_bloom_init(ht_bloom_t *bloom, size_t capacity) {
+    size_t bits = capacity * HT_BLOOM_BITS_PER_KEY;
+    size_t block_bits = HT_BLOOM_BLOCK_WORDS * 32;
+    bloom->block_count = bits / block_bits + 1;
+    bloom->capacity = capacity;
+    // Blocks are as large as their alignment, so one never straddles two
+    // cache lines
+    bloom->blocks = aligned_alloc(sizeof(ht_bloom_block_t),
+                                  bloom->block_count * sizeof(ht_bloom_block_t));
+    if (bloom->blocks == NULL) {
+        bloom->block_count = 0;
+        return false;
+    }
+    ht_bloom_clear(bloom);
+    return true;
+}
+
+/*
+ * Přidání hashe do filtru.
+ */
+void ht_bloom_add(ht_bloom_t *bloom, unsigned int hash) {
+    uint64_t x = ht_bloom_mix(hash);
+    ht_bloom_block_t *block = &bloom->blocks[ht_bloom_block_index(bloom, x)];
+    for (int i = 0; i < HT_BLOOM_BLOCK_WORDS; i++) {
+        block->words[i] |= 1u << (((uint32_t)x * HT_BLOOM_SALT[i]) >> 27);
+    }
+}
+
+/*
+ * Dotaz na hash. Vrací false, pokud prvek s tímto hashem do filtru určitě
+ * přidán nebyl.
+ */
+bool ht_bloom_may_contain(const ht_bloom_t *bloom, unsigned int hash) {
+    uint64_t x = ht_bloom_mix(hash);
+    const ht_bloom_block_t *block =
+        &bloom->blocks[ht_bloom_block_index(bloom, x)];
+    uint32_t missing = 0;
+    for (int i = 0; i < HT_BLOOM_BLOCK_WORDS; i++) {
+        uint32_t bit = 1u << (((uint32_t)x * HT_BLOOM_SALT[i]) >> 27);
+        missing |= bit & ~block->words[i];
+    }
+    return missing == 0;
+}
+
+/*
+ * Odebrání všech hashů z filtru.
+ */
+void ht_bloom_clear(ht_bloom_t *bloom) {
+    memset(bloom->blocks, 0, bloom->block_count * sizeof(ht_bloom_block_t));
+}
+
+/*
+ * Uvolnění bloků filtru.
+ */
+void ht_bloom_destroy(ht_bloom_t *bloom) {
+    free(bloom->blocks);
+    bloom->blocks = NULL;
+    bloom->block_count = 0;
+    bloom->capacity = 0;
+}
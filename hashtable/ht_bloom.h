@@ -0,0 +1,44 @@
+/*
+ * Hlavičkový soubor pro blokový Bloomův filtr nad hashi prvků tabulky.
+ *
+ * Filtr je rozdělený na bloky po 256 bitech (osm 32bitových slov, polovina
+ * řádku cache). Klíč vybere jeden blok a v každém slově bloku nastaví jeden
+ * bit, takže dotaz čte jediný řádek cache. Filtr pracuje s celým hashem
+ * prvku (ht_item_t.hash), klíč se kvůli němu znovu nehashuje. Odpověď
+ * "není" je vždy pravdivá, odpověď "možná je" může být falešně pozitivní.
+ * Mazat z filtru nejde, po smazání mnoha prvků se sestaví znovu.
+ */
+
+#ifndef IAL_HT_BLOOM_H
+#define IAL_HT_BLOOM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Počet 32bitových slov v bloku
+#define HT_BLOOM_BLOCK_WORDS 8
+
+// Počet bitů filtru na jeden očekávaný klíč (pro 10 vychází zhruba 1 %
+// falešně pozitivních odpovědí)
+#define HT_BLOOM_BITS_PER_KEY 10
+
+// Blok filtru
+typedef struct ht_bloom_block {
+  uint32_t words[HT_BLOOM_BLOCK_WORDS]; // v každém slově jeden bit na klíč
+} ht_bloom_block_t;
+
+// Filtr
+typedef struct ht_bloom {
+  ht_bloom_block_t *blocks; // bloky filtru
+  size_t block_count;       // počet bloků
+  size_t capacity;          // počet klíčů, pro který je filtr dimenzován
+} ht_bloom_t;
+
+bool ht_bloom_init(ht_bloom_t *bloom, size_t capacity);
+void ht_bloom_add(ht_bloom_t *bloom, unsigned int hash);
+bool ht_bloom_may_contain(const ht_bloom_t *bloom, unsigned int hash);
+void ht_bloom_clear(ht_bloom_t *bloom);
+void ht_bloom_destroy(ht_bloom_t *bloom);
+
+#endif
@@ -0,0 +1,304 @@
+/*
+ * Kompaktní tabulka zachovávající pořadí vložení
+ *
+ * Index se prochází lineárně od slotu daného dolními bity hashe. Položka
+ * indexu je buď číslo prvku, nebo jedna ze dvou nejvyšších hodnot dané
+ * šířky: prázdná a smazaná. Pole entries má místo pro 2/3 velikosti
+ * indexu, takže index nikdy není zaplněný víc než ze dvou třetin.
+ */
+
+#include "ht_compact.h"
+#include "ht_hash.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Hodnoty položky indexu pro šířku width bajtů
+#define HT_COMPACT_EMPTY(width) (UINT32_MAX >> (32 - 8 * (width)))
+#define HT_COMPACT_DELETED(width) (HT_COMPACT_EMPTY(width) - 1)
+
+static inline unsigned int ht_compact_hash(ht_compact_t *table, char *key) {
+    return ht_hash_fold(ht_hash_default(key, strlen(key), table->seed));
+}
+
+/*
+ * Nejmenší šířka položky indexu, do které se vejdou čísla prvků i obě
+ * zvláštní hodnoty, nebo 0, pokud je index příliš velký.
+ */
+static unsigned int ht_compact_width(size_t index_size) {
+    // Entries only fill 2/3 of the index, so a power-of-two size equal to
+    // the range of the width still leaves the top two values free
+    if (index_size - 1 <= UINT8_MAX) {
+        return 1;
+    }
+    if (index_size - 1 <= UINT16_MAX) {
+        return 2;
+    }
+    if (index_size - 1 <= UINT32_MAX) {
+        return 4;
+    }
+    return 0;
+}
+
+static inline uint32_t ht_compact_index_get(ht_compact_t *table, size_t i) {
+    switch (table->index_width) {
+    case 1:
+        return ((uint8_t *)table->index)[i];
+    case 2:
+        return ((uint16_t *)table->index)[i];
+    default:
+        return ((uint32_t *)table->index)[i];
+    }
+}
+
+static inline void ht_compact_index_set(ht_compact_t *table, size_t i,
+                                        uint32_t value) {
+    switch (table->index_width) {
+    case 1:
+        ((uint8_t *)table->index)[i] = (uint8_t)value;
+        break;
+    case 2:
+        ((uint16_t *)table->index)[i] = (uint16_t)value;
+        break;
+    default:
+        ((uint32_t *)table->index)[i] = value;
+        break;
+    }
+}
+
+/*
+ * Vyhledání klíče v indexu. Vrací true a slot indexu s klíčem, pokud klíč
+ * existuje; jinak vrací false a do *slot zapíše první slot, kam lze klíč
+ * vložit (smazaný, nebo prázdný, na kterém hledání skončilo).
+ */
+static bool ht_compact_find(ht_compact_t *table, unsigned int hash, char *key,
+                            size_t *slot) {
+    uint32_t empty = HT_COMPACT_EMPTY(table->index_width);
+    uint32_t deleted = HT_COMPACT_DELETED(table->index_width);
+    size_t mask = table->index_size - 1;
+    size_t free_slot = table->index_size;
+
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        uint32_t ix = ht_compact_index_get(table, i);
+        if (ix == empty) {
+            *slot = free_slot != table->index_size ? free_slot : i;
+            return false;
+        }
+        if (ix == deleted) {
+            if (free_slot == table->index_size) {
+                free_slot = i;
+            }
+            continue;
+        }
+        ht_compact_entry_t *entry = &table->entries[ix];
+        if (entry->hash == hash && strcmp(entry->key, key) == 0) {
+            *slot = i;
+            return true;
+        }
+    }
+}
+
+/*
+ * Přestavění tabulky s indexem o index_size položkách. Živé prvky se
+ * setřesou na začátek nového pole entries se zachováním pořadí a index se
+ * sestaví znovu z uložených hashů. Při nedostatku paměti vrací false
+ * a tabulka zůstává beze změny.
+ */
+static bool ht_compact_rebuild(ht_compact_t *table, size_t index_size) {
+    unsigned int width = ht_compact_width(index_size);
+    if (width == 0) {
+        return false;
+    }
+    size_t entry_capacity = index_size * 2 / 3;
+    void *index = malloc(index_size * width);
+    ht_compact_entry_t *entries =
+        malloc(entry_capacity * sizeof(ht_compact_entry_t));
+    if (index == NULL || entries == NULL) {
+        free(index);
+        free(entries);
+        return false;
+    }
+
+    size_t used = 0;
+    for (size_t i = 0; i < table->used; i++) {
+        if (table->entries[i].key != NULL) {
+            entries[used++] = table->entries[i];
+        }
+    }
+    free(table->index);
+    free(table->entries);
+    table->index = index;
+    table->index_size = index_size;
+    table->index_width = width;
+    table->entries = entries;
+    table->entry_capacity = entry_capacity;
+    table->used = used;
+
+    // All-ones bytes are the empty marker for every width
+    memset(index, 0xFF, index_size * width);
+    size_t mask = index_size - 1;
+    for (size_t ix = 0; ix < used; ix++) {
+        size_t i = entries[ix].hash & mask;
+        while (ht_compact_index_get(table, i) != HT_COMPACT_EMPTY(width)) {
+            i = (i + 1) & mask;
+        }
+        ht_compact_index_set(table, i, (uint32_t)ix);
+    }
+    return true;
+}
+
+/*
+ * Inicializace tabulky — zavolá se před prvním použitím tabulky.
+ *
+ * Vrací false, pokud se nepodařilo alokovat pole.
+ */
+bool ht_compact_init(ht_compact_t *table) {
+    table->index = NULL;
+    table->index_size = 0;
+    table->index_width = 1;
+    table->entries = NULL;
+    table->entry_capacity = 0;
+    table->used = 0;
+    table->count = 0;
+    table->seed = 0;
+    return ht_compact_rebuild(table, HT_COMPACT_INIT_INDEX);
+}
+
+/*
+ * Vyhledání prvku v tabulce.
+ *
+ * V případě úspěchu vrací ukazatel na prvek; v opačném případě vrací
+ * hodnotu NULL. Ukazatel je platný do další modifikace tabulky.
+ */
+ht_compact_entry_t *ht_compact_search(ht_compact_t *table, char *key) {
+    size_t slot;
+    if (ht_compact_find(table, ht_compact_hash(table, key), key, &slot)) {
+        return &table->entries[ht_compact_index_get(table, slot)];
+    }
+    return NULL;
+}
+
+/*
+ * Vložení nebo nalezení prvku.
+ *
+ * Pokud prvek s daným klíčem existuje, vrací ukazatel na jeho hodnotu beze
+ * změny, jinak připojí nový prvek s hodnotou value na konec pole entries.
+ * Ukazatel je platný do další modifikace tabulky. Při nedostatku paměti
+ * vrací NULL.
+ */
+float *ht_compact_upsert(ht_compact_t *table, char *key, float value) {
+    unsigned int hash = ht_compact_hash(table, key);
+    size_t slot;
+    if (ht_compact_find(table, hash, key, &slot)) {
+        return &table->entries[ht_compact_index_get(table, slot)].value;
+    }
+
+    if (table->used == table->entry_capacity) {
+        // Size the index for three times the live entries; when many were
+        // deleted this only squeezes them out without growing
+        size_t index_size = HT_COMPACT_INIT_INDEX;
+        while (index_size < (table->count + 1) * 3) {
+            index_size *= 2;
+        }
+        if (!ht_compact_rebuild(table, index_size)) {
+            return NULL;
+        }
+        ht_compact_find(table, hash, key, &slot);
+    }
+
+    size_t length = strlen(key);
+    char *copy = malloc(length + 1);
+    if (copy == NULL) {
+        return NULL;
+    }
+    memcpy(copy, key, length + 1);
+
+    ht_compact_entry_t *entry = &table->entries[table->used];
+    *entry = (ht_compact_entry_t){copy, value, hash};
+    ht_compact_index_set(table, slot, (uint32_t)table->used);
+    table->used++;
+    table->count++;
+    return &entry->value;
+}
+
+/*
+ * Vložení nového prvku do tabulky.
+ *
+ * Pokud prvek s daným klíčem už v tabulce existuje, nahradí se jeho hodnota
+ * a prvek si ponechá své místo v pořadí.
+ */
+void ht_compact_insert(ht_compact_t *table, char *key, float value) {
+    float *slot = ht_compact_upsert(table, key, value);
+    if (slot != NULL) {
+        *slot = value;
+    }
+}
+
+/*
+ * Získání hodnoty z tabulky.
+ *
+ * V případě úspěchu vrací funkce ukazatel na hodnotu prvku, v opačném
+ * případě hodnotu NULL.
+ */
+float *ht_compact_get(ht_compact_t *table, char *key) {
+    ht_compact_entry_t *entry = ht_compact_search(table, key);
+    return entry != NULL ? &entry->value : NULL;
+}
+
+/*
+ * Smazání prvku z tabulky.
+ *
+ * Položka indexu se označí jako smazaná a prvek v poli entries jako volný.
+ */
+void ht_compact_delete(ht_compact_t *table, char *key) {
+    size_t slot;
+    if (!ht_compact_find(table, ht_compact_hash(table, key), key, &slot)) {
+        return;
+    }
+    ht_compact_entry_t *entry =
+        &table->entries[ht_compact_index_get(table, slot)];
+    free(entry->key);
+    entry->key = NULL;
+    ht_compact_index_set(table, slot, HT_COMPACT_DELETED(table->index_width));
+    table->count--;
+}
+
+/*
+ * Smazání všech prvků z tabulky. Velikost indexu i pole entries se zachová.
+ */
+void ht_compact_delete_all(ht_compact_t *table) {
+    for (size_t i = 0; i < table->used; i++) {
+        free(table->entries[i].key);
+    }
+    memset(table->index, 0xFF, table->index_size * table->index_width);
+    table->used = 0;
+    table->count = 0;
+}
+
+/*
+ * Zrušení tabulky — uvolní všechny prvky, index i pole entries.
+ */
+void ht_compact_destroy(ht_compact_t *table) {
+    ht_compact_delete_all(table);
+    free(table->index);
+    free(table->entries);
+    table->index = NULL;
+    table->entries = NULL;
+    table->index_size = 0;
+    table->entry_capacity = 0;
+}
+
+/*
+ * Průchod prvky v pořadí vložení.
+ *
+ * Vrací první živý prvek od pozice *pos a posune *pos za něj; na konci vrací
+ * NULL. Průchod začíná s *pos == 0 a během něj se tabulka nesmí měnit.
+ */
+ht_compact_entry_t *ht_compact_next(ht_compact_t *table, size_t *pos) {
+    while (*pos < table->used) {
+        ht_compact_entry_t *entry = &table->entries[(*pos)++];
+        if (entry->key != NULL) {
+            return entry;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,53 @@
+/*
+ * Hlavičkový soubor pro kompaktní tabulku zachovávající pořadí vložení.
+ *
+ * Prvky leží za sebou v hustém poli entries v pořadí, v jakém byly vloženy.
+ * Vedle něj je řídké pole index s otevřeným adresováním, které obsahuje jen
+ * čísla prvků v poli entries. Šířka čísla (8, 16 nebo 32 bitů) se volí podle
+ * velikosti indexu, takže malá tabulka má index po bajtech. Průchod všemi
+ * prvky čte souvislý úsek paměti a prvek nepotřebuje ukazatel na synonymum.
+ *
+ * Smazaný prvek v poli entries jen uvolní klíč (key == NULL); místo se
+ * znovu využije až při přestavění tabulky, které prvky zároveň setřese.
+ */
+
+#ifndef IAL_HT_COMPACT_H
+#define IAL_HT_COMPACT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Počáteční velikost indexu (mocnina dvou)
+#define HT_COMPACT_INIT_INDEX 8
+
+// Prvek tabulky
+typedef struct ht_compact_entry {
+  char *key;         // kopie klíče, NULL pro smazaný prvek
+  float value;       // hodnota prvku
+  unsigned int hash; // celý hash klíče
+} ht_compact_entry_t;
+
+// Tabulka
+typedef struct ht_compact {
+  void *index;                 // řídký index s čísly prvků
+  size_t index_size;           // počet položek indexu (mocnina dvou)
+  unsigned int index_width;    // šířka položky indexu v bajtech (1, 2, 4)
+  ht_compact_entry_t *entries; // husté pole prvků v pořadí vložení
+  size_t entry_capacity;       // velikost pole entries
+  size_t used;                 // počet použitých míst v entries
+  size_t count;                // počet prvků
+  uint64_t seed;               // semínko rozptylovací funkce
+} ht_compact_t;
+
+bool ht_compact_init(ht_compact_t *table);
+ht_compact_entry_t *ht_compact_search(ht_compact_t *table, char *key);
+float *ht_compact_upsert(ht_compact_t *table, char *key, float value);
+void ht_compact_insert(ht_compact_t *table, char *key, float value);
+float *ht_compact_get(ht_compact_t *table, char *key);
+void ht_compact_delete(ht_compact_t *table, char *key);
+void ht_compact_delete_all(ht_compact_t *table);
+void ht_compact_destroy(ht_compact_t *table);
+ht_compact_entry_t *ht_compact_next(ht_compact_t *table, size_t *pos);
+
+#endif
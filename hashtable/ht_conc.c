@@ -0,0 +1,234 @@
+/*
+ * Tabulka s rozptýlenými položkami pro více vláken
+ *
+ * Každá operace spočítá hash mimo zámek, zamkne jen pruh klíče a teprve
+ * pod ním přečte pole řádků — zvětšení drží všechny zámky, takže pod
+ * kterýmkoliv z nich je pole konzistentní. Prvky se alokují i uvolňují
+ * stejně jako v ht_table_t (ht_item.h).
+ */
+
+#include "ht_conc.h"
+#include "ht_hash.h"
+#include "ht_item.h"
+#include <stdlib.h>
+#include <string.h>
+
+static inline pthread_mutex_t *ht_conc_lock_for(ht_conc_t *table,
+                                                unsigned int hash) {
+    return &table->stripes[hash & (HT_CONC_STRIPES - 1)].lock;
+}
+
+static void ht_conc_lock_all(ht_conc_t *table) {
+    // Always in the same order, so two resizers cannot deadlock
+    for (int i = 0; i < HT_CONC_STRIPES; i++) {
+        pthread_mutex_lock(&table->stripes[i].lock);
+    }
+}
+
+static void ht_conc_unlock_all(ht_conc_t *table) {
+    for (int i = HT_CONC_STRIPES - 1; i >= 0; i--) {
+        pthread_mutex_unlock(&table->stripes[i].lock);
+    }
+}
+
+/*
+ * Zdvojnásobení počtu řádků, pokud ho mezitím nezvětšilo jiné vlákno
+ * (tabulka má stále seen_size řádků). Při nedostatku paměti zůstane
+ * tabulka beze změny.
+ */
+static void ht_conc_grow(ht_conc_t *table, size_t seen_size) {
+    ht_conc_lock_all(table);
+    if (table->size == seen_size) {
+        size_t size = seen_size * 2;
+        ht_item_t **buckets = calloc(size, sizeof(ht_item_t *));
+        if (buckets != NULL) {
+            for (size_t i = 0; i < seen_size; i++) {
+                ht_item_t *item = table->buckets[i];
+                while (item != NULL) {
+                    ht_item_t *next = item->next;
+                    ht_item_t **bucket = &buckets[item->hash & (size - 1)];
+                    item->next = *bucket;
+                    *bucket = item;
+                    item = next;
+                }
+            }
+            free(table->buckets);
+            table->buckets = buckets;
+            table->size = size;
+        }
+    }
+    ht_conc_unlock_all(table);
+}
+
+/*
+ * Inicializace tabulky — zavolá se před prvním použitím tabulky, dřív než
+ * ji začne používat víc vláken.
+ *
+ * Vrací false, pokud se nepodařilo alokovat pole.
+ */
+bool ht_conc_init(ht_conc_t *table) {
+    table->buckets = calloc(HT_CONC_INIT_SIZE, sizeof(ht_item_t *));
+    if (table->buckets == NULL) {
+        return false;
+    }
+    for (int i = 0; i < HT_CONC_STRIPES; i++) {
+        pthread_mutex_init(&table->stripes[i].lock, NULL);
+    }
+    table->size = HT_CONC_INIT_SIZE;
+    atomic_init(&table->count, 0);
+    table->seed = 0;
+    return true;
+}
+
+/*
+ * Zápis hodnoty prvku pod zámkem jeho pruhu.
+ *
+ * Existující prvek dostane hodnotu value, nebo se k ní value přičte (add).
+ * Chybějící prvek se vloží s hodnotou value. Klíč delší než HT_ITEM_MAX_KEY
+ * se nevloží.
+ */
+static void ht_conc_put(ht_conc_t *table, char *key, float value, bool add) {
+    size_t length = strlen(key);
+    if (length > HT_ITEM_MAX_KEY) {
+        return;
+    }
+    unsigned int hash = ht_hash_fold(ht_hash_default(key, length, table->seed));
+    pthread_mutex_t *lock = ht_conc_lock_for(table, hash);
+
+    pthread_mutex_lock(lock);
+    ht_item_t **bucket = &table->buckets[hash & (table->size - 1)];
+    for (ht_item_t *item = *bucket; item != NULL; item = item->next) {
+        if (ht_item_matches(item, hash, key, length)) {
+            item->value = add ? item->value + value : value;
+            pthread_mutex_unlock(lock);
+            return;
+        }
+    }
+    ht_item_t *item = ht_item_new(key, length, hash, value);
+    if (item == NULL) {
+        pthread_mutex_unlock(lock);
+        return;
+    }
+    item->next = *bucket;
+    *bucket = item;
+    size_t size = table->size;
+    pthread_mutex_unlock(lock);
+
+    // Grow outside the stripe lock, ht_conc_grow takes all of them
+    size_t count = atomic_fetch_add(&table->count, 1) + 1;
+    if (count > size * HT_CONC_MAX_LOAD) {
+        ht_conc_grow(table, size);
+    }
+}
+
+/*
+ * Vložení nového prvku do tabulky.
+ *
+ * Pokud prvek s daným klíčem už v tabulce existuje, nahradí se jeho hodnota.
+ * Vkládání do různých pruhů probíhá souběžně.
+ */
+void ht_conc_insert(ht_conc_t *table, char *key, float value) {
+    ht_conc_put(table, key, value, false);
+}
+
+/*
+ * Přičtení delta k hodnotě prvku jedním vyhledáním pod zámkem pruhu,
+ * chybějící prvek se vloží s hodnotou delta. Souběžná přičtení ke stejnému
+ * klíči se neztratí.
+ */
+void ht_conc_add(ht_conc_t *table, char *key, float delta) {
+    ht_conc_put(table, key, delta, true);
+}
+
+/*
+ * Získání hodnoty z tabulky.
+ *
+ * V případě úspěchu zapíše hodnotu prvku do *value a vrací true, v opačném
+ * případě vrací false a *value nemění.
+ */
+bool ht_conc_get(ht_conc_t *table, char *key, float *value) {
+    size_t length = strlen(key);
+    if (length > HT_ITEM_MAX_KEY) {
+        return false;
+    }
+    unsigned int hash = ht_hash_fold(ht_hash_default(key, length, table->seed));
+    pthread_mutex_t *lock = ht_conc_lock_for(table, hash);
+
+    pthread_mutex_lock(lock);
+    ht_item_t *item = table->buckets[hash & (table->size - 1)];
+    while (item != NULL && !ht_item_matches(item, hash, key, length)) {
+        item = item->next;
+    }
+    if (item != NULL) {
+        *value = item->value;
+    }
+    pthread_mutex_unlock(lock);
+    return item != NULL;
+}
+
+/*
+ * Smazání prvku z tabulky. Paměť se uvolní až po odemčení pruhu.
+ */
+void ht_conc_delete(ht_conc_t *table, char *key) {
+    size_t length = strlen(key);
+    if (length > HT_ITEM_MAX_KEY) {
+        return;
+    }
+    unsigned int hash = ht_hash_fold(ht_hash_default(key, length, table->seed));
+    pthread_mutex_t *lock = ht_conc_lock_for(table, hash);
+
+    pthread_mutex_lock(lock);
+    ht_item_t **link = &table->buckets[hash & (table->size - 1)];
+    while (*link != NULL && !ht_item_matches(*link, hash, key, length)) {
+        link = &(*link)->next;
+    }
+    ht_item_t *item = *link;
+    if (item != NULL) {
+        *link = item->next;
+    }
+    pthread_mutex_unlock(lock);
+
+    if (item != NULL) {
+        ht_item_free(item);
+        atomic_fetch_sub(&table->count, 1);
+    }
+}
+
+/*
+ * Smazání všech prvků z tabulky. Drží všechny zámky, počet řádků se
+ * zachová.
+ */
+void ht_conc_delete_all(ht_conc_t *table) {
+    ht_conc_lock_all(table);
+    for (size_t i = 0; i < table->size; i++) {
+        ht_item_t *item = table->buckets[i];
+        while (item != NULL) {
+            ht_item_t *next = item->next;
+            ht_item_free(item);
+            item = next;
+        }
+        table->buckets[i] = NULL;
+    }
+    atomic_store(&table->count, 0);
+    ht_conc_unlock_all(table);
+}
+
+/*
+ * Zrušení tabulky — zavolá se, až ji žádné vlákno nepoužívá.
+ */
+void ht_conc_destroy(ht_conc_t *table) {
+    ht_conc_delete_all(table);
+    free(table->buckets);
+    table->buckets = NULL;
+    table->size = 0;
+    for (int i = 0; i < HT_CONC_STRIPES; i++) {
+        pthread_mutex_destroy(&table->stripes[i].lock);
+    }
+}
+
+/*
+ * Počet prvků v tabulce. Při souběžných změnách jde o okamžitý odhad.
+ */
+size_t ht_conc_count(ht_conc_t *table) {
+    return atomic_load(&table->count);
+}
@@ -0,0 +1,57 @@
+/*
+ * Hlavičkový soubor pro tabulku s rozptýlenými položkami pro více vláken.
+ *
+ * Řádky tabulky jsou rozdělené mezi HT_CONC_STRIPES zámků (lock striping):
+ * řádek i hlídá zámek i % HT_CONC_STRIPES. Vlákna pracující s klíči
+ * v různých pruzích se tedy navzájem neblokují. Počet řádků je mocnina dvou
+ * a násobek počtu pruhů, takže pruh klíče závisí jen na jeho hashi a při
+ * zvětšení tabulky zůstává stejný. Zvětšení si na chvíli vezme všechny
+ * zámky.
+ *
+ * Funkce ht_conc_get vrací kopii hodnoty, protože ukazatel do tabulky by
+ * mohl přestat platit, jakmile jiné vlákno prvek smaže.
+ */
+
+#ifndef IAL_HT_CONC_H
+#define IAL_HT_CONC_H
+
+#include "hashtable.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Počet zámků (mocnina dvou)
+#define HT_CONC_STRIPES 64
+
+// Počáteční počet řádků (mocnina dvou, násobek HT_CONC_STRIPES)
+#define HT_CONC_INIT_SIZE 1024
+
+// Maximální průměrný počet prvků na řádek před zvětšením tabulky
+#define HT_CONC_MAX_LOAD 1
+
+// Zámek jednoho pruhu, každý na vlastním řádku cache
+typedef struct ht_conc_stripe {
+  _Alignas(64) pthread_mutex_t lock;
+} ht_conc_stripe_t;
+
+// Tabulka
+typedef struct ht_conc {
+  ht_conc_stripe_t stripes[HT_CONC_STRIPES]; // zámky pruhů
+  ht_item_t **buckets;                       // pole seznamů synonym
+  size_t size;                               // počet řádků (mocnina dvou)
+  atomic_size_t count;                       // počet prvků
+  uint64_t seed;                             // semínko rozptylovací funkce
+} ht_conc_t;
+
+bool ht_conc_init(ht_conc_t *table);
+void ht_conc_insert(ht_conc_t *table, char *key, float value);
+void ht_conc_add(ht_conc_t *table, char *key, float delta);
+bool ht_conc_get(ht_conc_t *table, char *key, float *value);
+void ht_conc_delete(ht_conc_t *table, char *key);
+void ht_conc_delete_all(ht_conc_t *table);
+void ht_conc_destroy(ht_conc_t *table);
+size_t ht_conc_count(ht_conc_t *table);
+
+#endif
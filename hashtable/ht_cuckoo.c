@@ -0,0 +1,352 @@
+/*
+ * Tabulka s kukaččím hashováním po řádcích
+ *
+ * První řádek klíče určují dolní bity hashe, druhý řádek horní bity součinu
+ * hashe s lichou konstantou. Oba se počítají z uloženého hashe, takže při
+ * přesunu ani při zvětšení tabulky není potřeba klíč znovu hashovat. Jen
+ * když se prvky nepodaří rozmístit, změní se semínko a všechny klíče se
+ * hashují znovu — klíče se stejným hashem by jinak měly stejnou dvojici
+ * řádků při každé velikosti tabulky.
+ */
+
+#include "ht_cuckoo.h"
+#include "ht_hash.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Uzel při hledání cesty přesunů do šířky
+typedef struct ht_cuckoo_node {
+  size_t bucket; // řádek, ve kterém se hledá volný slot
+  int parent;    // uzel, ze kterého se sem přesouvá prvek, -1 pro kořen
+  int slot;      // slot v řádku rodiče s přesouvaným prvkem
+} ht_cuckoo_node_t;
+
+static inline unsigned int ht_cuckoo_key_hash(const char *key, uint64_t seed) {
+    return ht_hash_fold(ht_hash_default(key, strlen(key), seed));
+}
+
+static inline unsigned int ht_cuckoo_hash(ht_cuckoo_t *table, char *key) {
+    return ht_cuckoo_key_hash(key, table->seed);
+}
+
+static inline size_t ht_cuckoo_first(ht_cuckoo_t *table, unsigned int hash) {
+    return hash & (table->bucket_count - 1);
+}
+
+static inline size_t ht_cuckoo_second(ht_cuckoo_t *table, unsigned int hash) {
+    size_t first = ht_cuckoo_first(table, hash);
+    size_t second =
+        (size_t)((hash * 0x9E3779B97F4A7C15ull) >> 32) & (table->bucket_count - 1);
+    // Keep the two buckets distinct so each key really has two choices
+    return second != first ? second : first ^ 1;
+}
+
+/*
+ * Druhý z řádků prvku s hashem hash, který leží v řádku bucket.
+ */
+static inline size_t ht_cuckoo_other(ht_cuckoo_t *table, unsigned int hash,
+                                     size_t bucket) {
+    size_t first = ht_cuckoo_first(table, hash);
+    return bucket == first ? ht_cuckoo_second(table, hash) : first;
+}
+
+/*
+ * Vyhledání klíče v jednom řádku.
+ */
+static inline ht_cuckoo_slot_t *ht_cuckoo_bucket_find(ht_cuckoo_bucket_t *bucket,
+                                                      unsigned int hash,
+                                                      char *key) {
+    for (int i = 0; i < HT_CUCKOO_SLOTS; i++) {
+        ht_cuckoo_slot_t *slot = &bucket->slots[i];
+        if (slot->key != NULL && slot->hash == hash &&
+            strcmp(slot->key, key) == 0) {
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Index volného slotu v řádku, nebo -1 pokud je řádek plný.
+ */
+static inline int ht_cuckoo_bucket_free(ht_cuckoo_bucket_t *bucket) {
+    for (int i = 0; i < HT_CUCKOO_SLOTS; i++) {
+        if (bucket->slots[i].key == NULL) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Vyhledání klíče — přečte nejvýše dva řádky.
+ */
+static ht_cuckoo_slot_t *ht_cuckoo_find(ht_cuckoo_t *table, unsigned int hash,
+                                        char *key) {
+    ht_cuckoo_slot_t *slot = ht_cuckoo_bucket_find(
+        &table->buckets[ht_cuckoo_first(table, hash)], hash, key);
+    if (slot == NULL) {
+        slot = ht_cuckoo_bucket_find(
+            &table->buckets[ht_cuckoo_second(table, hash)], hash, key);
+    }
+    return slot;
+}
+
+/*
+ * Zda řádek bucket už leží na cestě od kořene k uzlu node.
+ */
+static bool ht_cuckoo_on_path(const ht_cuckoo_node_t *nodes, int node,
+                              size_t bucket) {
+    for (; node >= 0; node = nodes[node].parent) {
+        if (nodes[node].bucket == bucket) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Umístění prvku do jednoho z jeho dvou řádků, případně po přesunutí jiných
+ * prvků po nalezené cestě. Vrací slot nového prvku, nebo NULL, pokud cesta
+ * v mezích HT_CUCKOO_MAX_PATH_NODES neexistuje (tabulka se pak nemění).
+ */
+static ht_cuckoo_slot_t *ht_cuckoo_place(ht_cuckoo_t *table,
+                                         ht_cuckoo_slot_t entry) {
+    ht_cuckoo_node_t nodes[HT_CUCKOO_MAX_PATH_NODES];
+    int node_count = 0;
+    size_t roots[2] = {ht_cuckoo_first(table, entry.hash),
+                       ht_cuckoo_second(table, entry.hash)};
+
+    for (int r = 0; r < 2; r++) {
+        ht_cuckoo_bucket_t *bucket = &table->buckets[roots[r]];
+        int free_slot = ht_cuckoo_bucket_free(bucket);
+        if (free_slot >= 0) {
+            bucket->slots[free_slot] = entry;
+            return &bucket->slots[free_slot];
+        }
+        nodes[node_count++] = (ht_cuckoo_node_t){roots[r], -1, -1};
+    }
+
+    // Breadth-first search for an item that can move into a free slot
+    for (int i = 0; i < node_count; i++) {
+        ht_cuckoo_bucket_t *bucket = &table->buckets[nodes[i].bucket];
+        for (int s = 0; s < HT_CUCKOO_SLOTS; s++) {
+            size_t other =
+                ht_cuckoo_other(table, bucket->slots[s].hash, nodes[i].bucket);
+            int free_slot = ht_cuckoo_bucket_free(&table->buckets[other]);
+            if (free_slot >= 0) {
+                // Found a path: shift the items back towards the root
+                table->buckets[other].slots[free_slot] = bucket->slots[s];
+                int cur = i;
+                int vacated = s;
+                while (nodes[cur].parent >= 0) {
+                    ht_cuckoo_bucket_t *parent =
+                        &table->buckets[nodes[nodes[cur].parent].bucket];
+                    table->buckets[nodes[cur].bucket].slots[vacated] =
+                        parent->slots[nodes[cur].slot];
+                    vacated = nodes[cur].slot;
+                    cur = nodes[cur].parent;
+                }
+                ht_cuckoo_slot_t *slot =
+                    &table->buckets[nodes[cur].bucket].slots[vacated];
+                *slot = entry;
+                return slot;
+            }
+            if (node_count < HT_CUCKOO_MAX_PATH_NODES &&
+                !ht_cuckoo_on_path(nodes, i, other)) {
+                nodes[node_count++] = (ht_cuckoo_node_t){other, i, s};
+            }
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Přestavění tabulky s alespoň bucket_count řádky, pro reseed už první pokus
+ * s novým semínkem. Pokud se některý prvek nepodaří umístit, zkusí se další
+ * semínko a po každém druhém neúspěchu navíc dvojnásobek řádků, nejvýše
+ * HT_CUCKOO_MAX_REHASH pokusů. Při nedostatku paměti nebo po posledním
+ * neúspěšném pokusu vrací false a tabulka zůstává beze změny.
+ */
+static bool ht_cuckoo_rehash(ht_cuckoo_t *table, size_t bucket_count,
+                             bool reseed) {
+    ht_cuckoo_bucket_t *old_buckets = table->buckets;
+    size_t old_count = table->bucket_count;
+    uint64_t seed = table->seed;
+
+    for (int attempt = 0; attempt < HT_CUCKOO_MAX_REHASH; attempt++) {
+        if (reseed) {
+            seed += 0x9E3779B97F4A7C15ull;
+        }
+        ht_cuckoo_bucket_t *buckets =
+            aligned_alloc(sizeof(ht_cuckoo_bucket_t),
+                          bucket_count * sizeof(ht_cuckoo_bucket_t));
+        if (buckets == NULL) {
+            break;
+        }
+        memset(buckets, 0, bucket_count * sizeof(ht_cuckoo_bucket_t));
+        table->buckets = buckets;
+        table->bucket_count = bucket_count;
+
+        bool placed = true;
+        for (size_t b = 0; b < old_count && placed; b++) {
+            for (int s = 0; s < HT_CUCKOO_SLOTS && placed; s++) {
+                ht_cuckoo_slot_t entry = old_buckets[b].slots[s];
+                if (entry.key == NULL) {
+                    continue;
+                }
+                if (seed != table->seed) {
+                    entry.hash = ht_cuckoo_key_hash(entry.key, seed);
+                }
+                placed = ht_cuckoo_place(table, entry);
+            }
+        }
+        if (placed) {
+            free(old_buckets);
+            table->seed = seed;
+            return true;
+        }
+        free(buckets);
+        reseed = true;
+        if (attempt % 2 == 1) {
+            bucket_count *= 2;
+        }
+    }
+    table->buckets = old_buckets;
+    table->bucket_count = old_count;
+    return false;
+}
+
+/*
+ * Inicializace tabulky — zavolá se před prvním použitím tabulky.
+ *
+ * Vrací false, pokud se nepodařilo alokovat pole.
+ */
+bool ht_cuckoo_init(ht_cuckoo_t *table) {
+    table->count = 0;
+    table->seed = 0;
+    table->bucket_count = HT_CUCKOO_INIT_BUCKETS;
+    table->buckets = aligned_alloc(
+        sizeof(ht_cuckoo_bucket_t),
+        HT_CUCKOO_INIT_BUCKETS * sizeof(ht_cuckoo_bucket_t));
+    if (table->buckets == NULL) {
+        table->bucket_count = 0;
+        return false;
+    }
+    memset(table->buckets, 0,
+           HT_CUCKOO_INIT_BUCKETS * sizeof(ht_cuckoo_bucket_t));
+    return true;
+}
+
+/*
+ * Vyhledání prvku v tabulce.
+ *
+ * V případě úspěchu vrací ukazatel na slot prvku; v opačném případě vrací
+ * hodnotu NULL. Ukazatel je platný do další modifikace tabulky.
+ */
+ht_cuckoo_slot_t *ht_cuckoo_search(ht_cuckoo_t *table, char *key) {
+    return ht_cuckoo_find(table, ht_cuckoo_hash(table, key), key);
+}
+
+/*
+ * Vložení nebo nalezení prvku.
+ *
+ * Pokud prvek s daným klíčem existuje, vrací ukazatel na jeho hodnotu beze
+ * změny, jinak vloží nový prvek s hodnotou value. Ukazatel je platný do
+ * další modifikace tabulky. Při nedostatku paměti, nebo když se prvky
+ * nepodaří rozmístit ani po HT_CUCKOO_MAX_REHASH přestavěních, vrací NULL.
+ */
+float *ht_cuckoo_upsert(ht_cuckoo_t *table, char *key, float value) {
+    unsigned int hash = ht_cuckoo_hash(table, key);
+    ht_cuckoo_slot_t *slot = ht_cuckoo_find(table, hash, key);
+    if (slot != NULL) {
+        return &slot->value;
+    }
+
+    size_t capacity = table->bucket_count * HT_CUCKOO_SLOTS;
+    if ((table->count + 1) * 100 > capacity * HT_CUCKOO_MAX_LOAD &&
+        !ht_cuckoo_rehash(table, table->bucket_count * 2, false)) {
+        return NULL;
+    }
+
+    size_t length = strlen(key);
+    char *copy = malloc(length + 1);
+    if (copy == NULL) {
+        return NULL;
+    }
+    memcpy(copy, key, length + 1);
+
+    // The rehash may have changed the seed
+    ht_cuckoo_slot_t entry = {copy, value, ht_cuckoo_hash(table, copy)};
+    for (int attempt = 0; (slot = ht_cuckoo_place(table, entry)) == NULL;
+         attempt++) {
+        // No displacement path, try another seed before a bigger table
+        if (attempt == HT_CUCKOO_MAX_REHASH ||
+            !ht_cuckoo_rehash(table, table->bucket_count, true)) {
+            free(copy);
+            return NULL;
+        }
+        entry.hash = ht_cuckoo_hash(table, copy);
+    }
+    table->count++;
+    return &slot->value;
+}
+
+/*
+ * Vložení nového prvku do tabulky.
+ *
+ * Pokud prvek s daným klíčem už v tabulce existuje, nahradí se jeho hodnota.
+ */
+void ht_cuckoo_insert(ht_cuckoo_t *table, char *key, float value) {
+    float *slot = ht_cuckoo_upsert(table, key, value);
+    if (slot != NULL) {
+        *slot = value;
+    }
+}
+
+/*
+ * Získání hodnoty z tabulky.
+ *
+ * V případě úspěchu vrací funkce ukazatel na hodnotu prvku, v opačném
+ * případě hodnotu NULL.
+ */
+float *ht_cuckoo_get(ht_cuckoo_t *table, char *key) {
+    ht_cuckoo_slot_t *slot = ht_cuckoo_search(table, key);
+    return slot != NULL ? &slot->value : NULL;
+}
+
+/*
+ * Smazání prvku z tabulky. Slot se jen uvolní, ostatní prvky se nehýbou.
+ */
+void ht_cuckoo_delete(ht_cuckoo_t *table, char *key) {
+    ht_cuckoo_slot_t *slot = ht_cuckoo_search(table, key);
+    if (slot == NULL) {
+        return;
+    }
+    free(slot->key);
+    slot->key = NULL;
+    table->count--;
+}
+
+/*
+ * Smazání všech prvků z tabulky. Počet řádků se zachová.
+ */
+void ht_cuckoo_delete_all(ht_cuckoo_t *table) {
+    for (size_t b = 0; b < table->bucket_count; b++) {
+        for (int s = 0; s < HT_CUCKOO_SLOTS; s++) {
+            free(table->buckets[b].slots[s].key);
+            table->buckets[b].slots[s].key = NULL;
+        }
+    }
+    table->count = 0;
+}
+
+/*
+ * Zrušení tabulky — uvolní všechny prvky i pole řádků.
+ */
+void ht_cuckoo_destroy(ht_cuckoo_t *table) {
+    ht_cuckoo_delete_all(table);
+    free(table->buckets);
+    table->buckets = NULL;
+    table->bucket_count = 0;
+}
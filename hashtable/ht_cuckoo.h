@@ -0,0 +1,64 @@
+/*
+ * Hlavičkový soubor pro tabulku s kukaččím hashováním po řádcích.
+ *
+ * Každý klíč může ležet jen v jednom ze dvou řádků daných dvěma
+ * rozptylovacími funkcemi. Řádek má HT_CUCKOO_SLOTS slotů a zabírá právě
+ * jeden řádek cache (64 B), takže vyhledání přečte nejvýše dva řádky cache
+ * bez ohledu na zaplnění tabulky. Pokud jsou při vkládání oba řádky plné,
+ * hledá se do šířky cesta přesunů prvků do jejich alternativních řádků.
+ * Když cesta neexistuje, tabulka se přestaví s novým semínkem, případně
+ * se zvětší.
+ */
+
+#ifndef IAL_HT_CUCKOO_H
+#define IAL_HT_CUCKOO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Počet slotů v řádku
+#define HT_CUCKOO_SLOTS 4
+
+// Počáteční počet řádků (mocnina dvou)
+#define HT_CUCKOO_INIT_BUCKETS 32
+
+// Maximální zaplnění v procentech
+#define HT_CUCKOO_MAX_LOAD 90
+
+// Maximální počet uzlů při hledání cesty přesunů
+#define HT_CUCKOO_MAX_PATH_NODES 512
+
+// Maximální počet pokusů o přestavění (semínka a zvětšení) při jednom růstu
+#define HT_CUCKOO_MAX_REHASH 16
+
+// Slot tabulky
+typedef struct ht_cuckoo_slot {
+  char *key;         // kopie klíče, NULL pro prázdný slot
+  float value;       // hodnota prvku
+  unsigned int hash; // celý hash klíče (určuje oba řádky)
+} ht_cuckoo_slot_t;
+
+// Řádek tabulky, zarovnaný na řádek cache
+typedef struct ht_cuckoo_bucket {
+  _Alignas(64) ht_cuckoo_slot_t slots[HT_CUCKOO_SLOTS];
+} ht_cuckoo_bucket_t;
+
+// Tabulka
+typedef struct ht_cuckoo {
+  ht_cuckoo_bucket_t *buckets; // pole řádků
+  size_t bucket_count;         // počet řádků (mocnina dvou)
+  size_t count;                // počet prvků
+  uint64_t seed;               // semínko rozptylovací funkce
+} ht_cuckoo_t;
+
+bool ht_cuckoo_init(ht_cuckoo_t *table);
+ht_cuckoo_slot_t *ht_cuckoo_search(ht_cuckoo_t *table, char *key);
+float *ht_cuckoo_upsert(ht_cuckoo_t *table, char *key, float value);
+void ht_cuckoo_insert(ht_cuckoo_t *table, char *key, float value);
+float *ht_cuckoo_get(ht_cuckoo_t *table, char *key);
+void ht_cuckoo_delete(ht_cuckoo_t *table, char *key);
+void ht_cuckoo_delete_all(ht_cuckoo_t *table);
+void ht_cuckoo_destroy(ht_cuckoo_t *table);
+
+#endif
@@ -0,0 +1,557 @@
+/*
+ * Zmrazená tabulka s minimální perfektní rozptylovací funkcí
+ *
+ * Stavba: klíče se zahashují, rozdělí do skupin podle horních bitů hashe
+ * a skupiny se od největší umisťují na volné pozice. Pro skupinu se zkouší
+ * posunutí 0, 1, 2, ..., dokud všechny její klíče nepadnou na různé volné
+ * pozice. Velké skupiny přijdou na řadu, dokud je volných pozic hodně,
+ * na malé skupiny na konci stačí pár pokusů.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ht_frozen.h"
+#include "ht_hash.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Klíč při stavbě
+typedef struct ht_frozen_key {
+  const char *key;     // klíč ve zdrojové tabulce
+  size_t length;       // délka klíče
+  float value;         // hodnota
+  uint64_t hash;       // hash klíče se semínkem stavby
+  size_t slot;         // přidělená pozice
+} ht_frozen_key_t;
+
+// Hlavička souboru se zmrazenou tabulkou, za ní následuje blok memory
+typedef struct ht_frozen_header {
+  uint64_t magic;        // HT_FROZEN_MAGIC, pozná i jiné pořadí bajtů
+  uint32_t hash;         // HT_HASH, se kterou byla tabulka postavena
+  uint32_t width;        // šířka posunutí v bajtech
+  uint64_t count;        // počet klíčů
+  uint64_t slot_count;   // počet pozic
+  uint64_t bucket_count; // počet skupin
+  uint64_t seed;         // semínko rozptylovací funkce
+  uint64_t memory_size;  // velikost bloku za hlavičkou
+} ht_frozen_header_t;
+
+/*
+ * Mapování čísla z <0, 2^32) na <0, n) násobením místo modula.
+ */
+static inline size_t ht_frozen_range(uint32_t x, size_t n) {
+    return (size_t)(((uint64_t)x * n) >> 32);
+}
+
+/*
+ * Skupina klíče s hashem hash.
+ *
+ * Skupiny jsou nerovnoměrné (jako v PTHash): 60 % klíčů padne do prvních
+ * 30 % skupin. Velké skupiny se umisťují do skoro prázdné tabulky a na
+ * konec zbudou hlavně skupiny s jedním nebo dvěma klíči, pro které se volné
+ * pozice najdou rychle.
+ */
+static inline size_t ht_frozen_bucket(const ht_frozen_t *frozen,
+                                      uint64_t hash) {
+    size_t dense = frozen->bucket_count * 3 / 10;
+    if ((uint32_t)(hash >> 32) < (uint32_t)(0.6 * UINT32_MAX)) {
+        return ht_frozen_range((uint32_t)hash, dense);
+    }
+    return dense + ht_frozen_range((uint32_t)hash,
+                                   frozen->bucket_count - dense);
+}
+
+/*
+ * Rozmíchání 64bitového čísla (finalizér splitmix64).
+ */
+static inline uint64_t ht_frozen_mix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/*
+ * Pozice klíče při posunutí skupiny s rozmíchanou hodnotou pilot. Klíč
+ * přispívá rozmíchaným hashem base, takže při stavbě stačí na klíč a pokus
+ * jeden xor a jedno násobení (to přenese rozdíl v kterémkoliv bitu do
+ * horních bitů, podle kterých se vybírá pozice).
+ */
+static inline size_t ht_frozen_position(const ht_frozen_t *frozen,
+                                        uint64_t base, uint64_t pilot) {
+    uint64_t x = (base ^ pilot) * 0x9E3779B97F4A7C15ull;
+    return ht_frozen_range((uint32_t)(x >> 32), frozen->slot_count);
+}
+
+static inline uint32_t ht_frozen_displacement(const ht_frozen_t *frozen,
+                                              size_t bucket) {
+    switch (frozen->width) {
+    case 1:
+        return ((uint8_t *)frozen->displacements)[bucket];
+    case 2:
+        return ((uint16_t *)frozen->displacements)[bucket];
+    default:
+        return ((uint32_t *)frozen->displacements)[bucket];
+    }
+}
+
+static inline void ht_frozen_set_displacement(ht_frozen_t *frozen,
+                                              size_t bucket, uint32_t value) {
+    switch (frozen->width) {
+    case 1:
+        ((uint8_t *)frozen->displacements)[bucket] = (uint8_t)value;
+        break;
+    case 2:
+        ((uint16_t *)frozen->displacements)[bucket] = (uint16_t)value;
+        break;
+    default:
+        ((uint32_t *)frozen->displacements)[bucket] = value;
+        break;
+    }
+}
+
+/*
+ * Začátek klíčů v bloku memory. Blok obsahuje nejdřív 4bajtová pole
+ * (values, offsets, remap), pak posunutí a nakonec klíče, takže žádné pole
+ * nepotřebuje zarovnání navíc.
+ */
+static size_t ht_frozen_keys_at(const ht_frozen_t *frozen) {
+    return frozen->count * sizeof(float) +
+           (frozen->count + 1) * sizeof(uint32_t) +
+           (frozen->slot_count - frozen->count) * sizeof(uint32_t) +
+           frozen->bucket_count * frozen->width;
+}
+
+/*
+ * Nastavení ukazatelů na pole uvnitř bloku memory podle počtů ve frozen.
+ */
+static void ht_frozen_attach(ht_frozen_t *frozen, char *memory) {
+    frozen->memory = memory;
+    frozen->values = (float *)memory;
+    frozen->offsets = (uint32_t *)(memory + frozen->count * sizeof(float));
+    frozen->remap = frozen->offsets + frozen->count + 1;
+    frozen->displacements =
+        frozen->remap + (frozen->slot_count - frozen->count);
+    frozen->keys = (char *)frozen->displacements +
+                   frozen->bucket_count * frozen->width;
+}
+
+/*
+ * Umístění všech skupin pro semínko frozen->seed. Do keys[i].slot zapíše
+ * pozici klíče a do displacement[b] posunutí skupiny b. Vrací false, pokud
+ * některá skupina nejde umístit (pak se zkusí jiné semínko) nebo chybí
+ * paměť.
+ */
+static bool ht_frozen_place(ht_frozen_t *frozen, ht_frozen_key_t *keys,
+                            uint32_t *displacement) {
+    size_t n = frozen->count;
+    size_t buckets = frozen->bucket_count;
+    size_t *first = calloc(buckets + 1, sizeof(size_t));
+    size_t *order = malloc((n + 1) * sizeof(size_t));
+    unsigned char *taken = calloc(frozen->slot_count, 1);
+    size_t *by_size = NULL;
+    size_t *size_first = NULL;
+    uint64_t *bases = NULL;
+    size_t *slots = NULL;
+    bool placed = false;
+    if (first == NULL || order == NULL || taken == NULL) {
+        goto cleanup;
+    }
+
+    // Counting sort of the keys by bucket
+    for (size_t i = 0; i < n; i++) {
+        keys[i].hash = ht_hash_default(keys[i].key, keys[i].length,
+                                       frozen->seed);
+        first[ht_frozen_bucket(frozen, keys[i].hash) + 1]++;
+    }
+    size_t largest = 0;
+    for (size_t b = 0; b < buckets; b++) {
+        if (first[b + 1] > largest) {
+            largest = first[b + 1];
+        }
+        first[b + 1] += first[b];
+    }
+    // first[b] runs to the end of bucket b, shift it back to its start
+    for (size_t i = 0; i < n; i++) {
+        order[first[ht_frozen_bucket(frozen, keys[i].hash)]++] = i;
+    }
+    for (size_t b = buckets; b > 0; b--) {
+        first[b] = first[b - 1];
+    }
+    first[0] = 0;
+
+    // Counting sort of the buckets by size, largest first
+    by_size = malloc(buckets * sizeof(size_t));
+    size_first = calloc(largest + 2, sizeof(size_t));
+    bases = malloc((n + 1) * sizeof(uint64_t));
+    slots = malloc((n + 1) * sizeof(size_t));
+    if (by_size == NULL || size_first == NULL || bases == NULL ||
+        slots == NULL) {
+        goto cleanup;
+    }
+    // The search below reads the keys of a bucket from one contiguous run
+    for (size_t k = 0; k < n; k++) {
+        bases[k] = ht_frozen_mix(keys[order[k]].hash);
+    }
+    for (size_t b = 0; b < buckets; b++) {
+        size_first[largest - (first[b + 1] - first[b]) + 1]++;
+    }
+    for (size_t s = 0; s <= largest; s++) {
+        size_first[s + 1] += size_first[s];
+    }
+    for (size_t b = 0; b < buckets; b++) {
+        by_size[size_first[largest - (first[b + 1] - first[b])]++] = b;
+    }
+
+    memset(displacement, 0, buckets * sizeof(uint32_t));
+    for (size_t i = 0; i < buckets; i++) {
+        size_t b = by_size[i];
+        if (first[b] == first[b + 1]) {
+            // Buckets are sorted by size, the rest are empty too
+            break;
+        }
+        uint32_t d = 0;
+        for (; d < HT_FROZEN_MAX_DISPLACEMENT; d++) {
+            uint64_t pilot = ht_frozen_mix(d + 1);
+            size_t k = first[b];
+            // Claim positions tentatively (2) so that two keys of the same
+            // bucket cannot land on one position either
+            for (; k < first[b + 1]; k++) {
+                slots[k] = ht_frozen_position(frozen, bases[k], pilot);
+                if (taken[slots[k]] != 0) {
+                    break;
+                }
+                taken[slots[k]] = 2;
+            }
+            if (k == first[b + 1]) {
+                break;
+            }
+            while (k-- > first[b]) {
+                taken[slots[k]] = 0;
+            }
+        }
+        if (d == HT_FROZEN_MAX_DISPLACEMENT) {
+            goto cleanup;
+        }
+        for (size_t k = first[b]; k < first[b + 1]; k++) {
+            taken[slots[k]] = 1;
+            keys[order[k]].slot = slots[k];
+        }
+        displacement[b] = d;
+    }
+    placed = true;
+
+cleanup:
+    free(slots);
+    free(bases);
+    free(size_first);
+    free(by_size);
+    free(taken);
+    free(order);
+    free(first);
+    return placed;
+}
+
+/*
+ * Stavba zmrazené tabulky z pole count různých klíčů.
+ */
+static bool ht_frozen_build(ht_frozen_t *frozen, ht_frozen_key_t *keys,
+                            size_t count) {
+    memset(frozen, 0, sizeof(ht_frozen_t));
+    frozen->count = count;
+    frozen->slot_count = count * HT_FROZEN_SLOTS_PER_100 / 100 + 1;
+    frozen->bucket_count = count / HT_FROZEN_BUCKET_KEYS + 4;
+    uint32_t *displacement = malloc(frozen->bucket_count * sizeof(uint32_t));
+    if (displacement == NULL) {
+        return false;
+    }
+    bool placed = false;
+    for (unsigned int attempt = 0; attempt < HT_FROZEN_MAX_SEEDS && !placed;
+         attempt++) {
+        frozen->seed = attempt * 0x9E3779B97F4A7C15ull;
+        placed = ht_frozen_place(frozen, keys, displacement);
+    }
+    if (!placed) {
+        free(displacement);
+        return false;
+    }
+
+    uint32_t largest = 0;
+    size_t key_bytes = 0;
+    for (size_t b = 0; b < frozen->bucket_count; b++) {
+        largest = displacement[b] > largest ? displacement[b] : largest;
+    }
+    for (size_t i = 0; i < count; i++) {
+        key_bytes += keys[i].length + 1;
+    }
+    frozen->width = largest <= UINT8_MAX ? 1 : largest <= UINT16_MAX ? 2 : 4;
+
+    frozen->memory_size = ht_frozen_keys_at(frozen) + key_bytes;
+    if (key_bytes > UINT32_MAX ||
+        (frozen->memory = malloc(frozen->memory_size)) == NULL) {
+        free(displacement);
+        return false;
+    }
+    ht_frozen_attach(frozen, frozen->memory);
+    size_t remap_count = frozen->slot_count - count;
+    for (size_t b = 0; b < frozen->bucket_count; b++) {
+        ht_frozen_set_displacement(frozen, b, displacement[b]);
+    }
+    free(displacement);
+    // Unused positions past the last key still need a valid target, the
+    // key comparison rejects whatever lands there
+    memset(frozen->remap, 0, remap_count * sizeof(uint32_t));
+
+    // Positions past the last key move to the free positions below it;
+    // there are exactly as many of each
+    unsigned char *used = calloc(count + 1, 1);
+    if (used == NULL) {
+        ht_frozen_destroy(frozen);
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (keys[i].slot < count) {
+            used[keys[i].slot] = 1;
+        }
+    }
+    size_t free_slot = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (keys[i].slot >= count) {
+            while (used[free_slot]) {
+                free_slot++;
+            }
+            used[free_slot] = 1;
+            frozen->remap[keys[i].slot - count] = (uint32_t)free_slot;
+            keys[i].slot = free_slot;
+        }
+    }
+    free(used);
+
+    // Lay the keys out in position order, offsets[i + 1] marks the end
+    uint32_t *lengths = frozen->offsets + 1;
+    for (size_t i = 0; i < count; i++) {
+        lengths[keys[i].slot] = keys[i].length + 1;
+        frozen->values[keys[i].slot] = keys[i].value;
+    }
+    frozen->offsets[0] = 0;
+    for (size_t i = 0; i < count; i++) {
+        frozen->offsets[i + 1] += frozen->offsets[i];
+    }
+    for (size_t i = 0; i < count; i++) {
+        memcpy(frozen->keys + frozen->offsets[keys[i].slot], keys[i].key,
+               keys[i].length + 1);
+    }
+    return true;
+}
+
+/*
+ * Zmrazení tabulky s pevnou velikostí. Zdrojová tabulka se nemění.
+ *
+ * Vrací false při nedostatku paměti.
+ */
+bool ht_freeze(ht_frozen_t *frozen, ht_table_t *table) {
+    size_t count = 0;
+    for (int i = 0; i < HT_SIZE; i++) {
+        for (ht_item_t *item = (*table)[i]; item != NULL; item = item->next) {
+            count++;
+        }
+    }
+    ht_frozen_key_t *keys = malloc((count + 1) * sizeof(ht_frozen_key_t));
+    if (keys == NULL) {
+        return false;
+    }
+    size_t k = 0;
+    for (int i = 0; i < HT_SIZE; i++) {
+        for (ht_item_t *item = (*table)[i]; item != NULL; item = item->next) {
+            keys[k++] = (ht_frozen_key_t){.key = item->key,
+                                          .length = item->key_len,
+                                          .value = item->value};
+        }
+    }
+    bool built = ht_frozen_build(frozen, keys, count);
+    free(keys);
+    return built;
+}
+
+/*
+ * Zmrazení rostoucí tabulky. Zdrojová tabulka se nemění.
+ *
+ * Vrací false při nedostatku paměti.
+ */
+bool ht_map_freeze(ht_frozen_t *frozen, ht_map_t *map) {
+    ht_frozen_key_t *keys = malloc((map->count + 1) * sizeof(ht_frozen_key_t));
+    if (keys == NULL) {
+        return false;
+    }
+    size_t k = 0;
+    for (size_t i = 0; i < map->size; i++) {
+        for (ht_item_t *item = map->buckets[i]; item != NULL;
+             item = item->next) {
+            keys[k++] = (ht_frozen_key_t){.key = item->key,
+                                          .length = item->key_len,
+                                          .value = item->value};
+        }
+    }
+    // Migrated rows of the old array are already empty
+    for (size_t i = 0; i < map->old_size; i++) {
+        for (ht_item_t *item = map->old_buckets[i]; item != NULL;
+             item = item->next) {
+            keys[k++] = (ht_frozen_key_t){.key = item->key,
+                                          .length = item->key_len,
+                                          .value = item->value};
+        }
+    }
+    bool built = ht_frozen_build(frozen, keys, k);
+    free(keys);
+    return built;
+}
+
+/*
+ * Získání hodnoty ze zmrazené tabulky.
+ *
+ * Vždy se přečte jedno posunutí a porovná jeden klíč. V případě úspěchu
+ * vrací ukazatel na hodnotu, v opačném případě NULL.
+ */
+float *ht_frozen_get(ht_frozen_t *frozen, char *key) {
+    return ht_frozen_get_n(frozen, key, strlen(key));
+}
+
+/*
+ * Získání hodnoty klíče key délky length, který nemusí být ukončený nulou,
+ * viz ht_frozen_get.
+ */
+float *ht_frozen_get_n(ht_frozen_t *frozen, const char *key, size_t length) {
+    if (frozen->count == 0) {
+        return NULL;
+    }
+    uint64_t hash = ht_hash_default(key, length, frozen->seed);
+    uint32_t displacement =
+        ht_frozen_displacement(frozen, ht_frozen_bucket(frozen, hash));
+    size_t slot = ht_frozen_position(frozen, ht_frozen_mix(hash),
+                                     ht_frozen_mix(displacement + 1));
+    if (slot >= frozen->count) {
+        slot = frozen->remap[slot - frozen->count];
+    }
+    uint32_t begin = frozen->offsets[slot];
+    if (frozen->offsets[slot + 1] - begin != length + 1 ||
+        memcmp(frozen->keys + begin, key, length) != 0) {
+        return NULL;
+    }
+    return &frozen->values[slot];
+}
+
+/*
+ * Klíč na pozici position (0 až count - 1), pro průchod všemi prvky.
+ */
+const char *ht_frozen_key(ht_frozen_t *frozen, size_t position) {
+    return frozen->keys + frozen->offsets[position];
+}
+
+/*
+ * Uložení zmrazené tabulky do souboru path: hlavička a za ní blok memory
+ * beze změny.
+ *
+ * Vrací false, pokud soubor nejde zapsat.
+ */
+bool ht_frozen_save(ht_frozen_t *frozen, const char *path) {
+    ht_frozen_header_t header = {.magic = HT_FROZEN_MAGIC,
+                                 .hash = HT_HASH,
+                                 .width = frozen->width,
+                                 .count = frozen->count,
+                                 .slot_count = frozen->slot_count,
+                                 .bucket_count = frozen->bucket_count,
+                                 .seed = frozen->seed,
+                                 .memory_size = frozen->memory_size};
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        return false;
+    }
+    bool written =
+        fwrite(&header, sizeof(header), 1, f) == 1 &&
+        fwrite(frozen->memory, 1, frozen->memory_size, f) ==
+            frozen->memory_size;
+    return fclose(f) == 0 && written;
+}
+
+/*
+ * Načtení zmrazené tabulky ze souboru path uloženého ht_frozen_save.
+ *
+ * Soubor se jen namapuje (mmap) a ukazatele se nastaví dovnitř mapování,
+ * nic se nekopíruje ani nealokuje; stránky načte systém až při prvním
+ * přístupu. Mapování je soukromé, zápis přes ukazatel z ht_frozen_get
+ * soubor nezmění. Kontroluje se hlavička a velikosti, obsah bloku ne —
+ * soubor musí pocházet z ht_frozen_save.
+ *
+ * Vrací false, pokud soubor nejde namapovat nebo nemá správný formát.
+ */
+bool ht_frozen_load(ht_frozen_t *frozen, const char *path) {
+    memset(frozen, 0, sizeof(ht_frozen_t));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        (size_t)st.st_size < sizeof(ht_frozen_header_t)) {
+        close(fd);
+        return false;
+    }
+    size_t size = (size_t)st.st_size;
+    char *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    ht_frozen_header_t header;
+    memcpy(&header, data, sizeof(header));
+    size_t memory_size = size - sizeof(header);
+    // Every array element takes at least a byte, which also keeps the
+    // layout arithmetic below from overflowing
+    bool valid = header.magic == HT_FROZEN_MAGIC && header.hash == HT_HASH &&
+                 (header.width == 1 || header.width == 2 ||
+                  header.width == 4) &&
+                 header.memory_size == memory_size &&
+                 header.count <= header.slot_count &&
+                 header.slot_count <= memory_size &&
+                 header.bucket_count > 0 && header.bucket_count <= memory_size;
+    if (valid) {
+        frozen->count = header.count;
+        frozen->slot_count = header.slot_count;
+        frozen->bucket_count = header.bucket_count;
+        frozen->seed = header.seed;
+        frozen->width = header.width;
+        frozen->memory_size = memory_size;
+        size_t keys_at = ht_frozen_keys_at(frozen);
+        valid = keys_at <= memory_size;
+        if (valid) {
+            ht_frozen_attach(frozen, data + sizeof(header));
+            valid = frozen->offsets[frozen->count] == memory_size - keys_at;
+        }
+    }
+    if (!valid) {
+        munmap(data, size);
+        memset(frozen, 0, sizeof(ht_frozen_t));
+        return false;
+    }
+    frozen->mapped = true;
+    return true;
+}
+
+/*
+ * Uvolnění zmrazené tabulky postavené ht_freeze nebo načtené
+ * ht_frozen_load.
+ */
+void ht_frozen_destroy(ht_frozen_t *frozen) {
+    if (frozen->mapped) {
+        munmap((char *)frozen->memory - sizeof(ht_frozen_header_t),
+               sizeof(ht_frozen_header_t) + frozen->memory_size);
+    } else {
+        free(frozen->memory);
+    }
+    memset(frozen, 0, sizeof(ht_frozen_t));
+}
@@ -0,0 +1,74 @@
+/*
+ * Hlavičkový soubor pro zmrazenou tabulku s minimální perfektní
+ * rozptylovací funkcí.
+ *
+ * Funkce ht_freeze / ht_map_freeze postaví z hotové tabulky strukturu jen
+ * pro čtení. Klíče se rozdělí do skupin (v průměru HT_FROZEN_BUCKET_KEYS
+ * klíčů) a každá skupina dostane číslo posunutí, se kterým se všechny její
+ * klíče rozptýlí na různé volné pozice (hash-and-displace, CHD/PTHash).
+ * Pozic je o pár procent víc než klíčů; pozice za posledním klíčem se
+ * přemapují na zbylé volné pozice, takže klíč i s hodnotou leží v hustém
+ * poli o přesně count položkách. Vyhledání tak vždy čte jedno posunutí
+ * a jednu pozici a porovná jediný klíč; prvky nemají ukazatel next.
+ *
+ * Všechna pole leží v jednom bloku memory a odkazují se jen indexy, ne
+ * ukazateli, takže blok lze beze změny uložit a znovu namapovat:
+ * ht_frozen_save zapíše hlavičku a blok do souboru, ht_frozen_load soubor
+ * namapuje a hledá přímo v něm bez jediné alokace. Uložení naplněné
+ * tabulky je tak ht_map_freeze + ht_frozen_save a studený start jen mmap
+ * místo vkládání klíčů po jednom. Soubor používá nativní pořadí bajtů
+ * a rozptylovací funkci zvolenou při překladu (HT_HASH); soubor z jiného
+ * sestavení ht_frozen_load odmítne.
+ */
+
+#ifndef IAL_HT_FROZEN_H
+#define IAL_HT_FROZEN_H
+
+#include "hashtable.h"
+#include "ht_map.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Průměrný počet klíčů ve skupině se společným posunutím
+#define HT_FROZEN_BUCKET_KEYS 3
+
+// Počet pozic na 100 klíčů (zbytek do 100 % jsou volné pozice)
+#define HT_FROZEN_SLOTS_PER_100 102
+
+// Nejvyšší zkoušené posunutí, pak se stavba zopakuje s jiným semínkem
+#define HT_FROZEN_MAX_DISPLACEMENT (1u << 20)
+
+// Počet semínek, která se zkusí, než stavba selže
+#define HT_FROZEN_MAX_SEEDS 16
+
+// Značka na začátku souboru s uloženou tabulkou ("HTFROZE1")
+#define HT_FROZEN_MAGIC 0x31455A4F52465448ull
+
+// Zmrazená tabulka
+typedef struct ht_frozen {
+  size_t count;        // počet klíčů
+  size_t slot_count;   // počet pozic rozptylovací funkce
+  size_t bucket_count; // počet skupin
+  uint64_t seed;       // semínko rozptylovací funkce
+  unsigned int width;  // šířka posunutí v bajtech (1, 2, 4)
+  float *values;       // hodnoty podle pozice, count položek
+  uint32_t *offsets;   // začátky klíčů v keys, count + 1 položek
+  uint32_t *remap;     // cíl pozic od count dál
+  void *displacements; // posunutí skupin
+  char *keys;          // klíče ukončené nulou v pořadí pozic
+  void *memory;        // blok se všemi poli
+  size_t memory_size;  // velikost bloku memory
+  bool mapped;         // memory leží v mapovaném souboru
+} ht_frozen_t;
+
+bool ht_freeze(ht_frozen_t *frozen, ht_table_t *table);
+bool ht_map_freeze(ht_frozen_t *frozen, ht_map_t *map);
+float *ht_frozen_get(ht_frozen_t *frozen, char *key);
+float *ht_frozen_get_n(ht_frozen_t *frozen, const char *key, size_t length);
+const char *ht_frozen_key(ht_frozen_t *frozen, size_t position);
+bool ht_frozen_save(ht_frozen_t *frozen, const char *path);
+bool ht_frozen_load(ht_frozen_t *frozen, const char *path);
+void ht_frozen_destroy(ht_frozen_t *frozen);
+
+#endif
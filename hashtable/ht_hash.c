@@ -0,0 +1,146 @@
+/*
+ * Rozptylovací funkce řetězců
+ *
+ * ht_hash_wy je zjednodušený wyhash (Wang Yi, public domain) — klíč čte po
+ * 8 bajtech a míchá je 64×64→128bitovým násobením. Pro přenositelnost
+ * výsledků se čte vždy v pořadí little-endian.
+ */
+
+#include "ht_hash.h"
+#include <string.h>
+
+static const uint64_t HT_WY_P0 = 0x2d358dccaa6c78a5ull;
+static const uint64_t HT_WY_P1 = 0x8bb84b93962eacc9ull;
+static const uint64_t HT_WY_P2 = 0x4b33a62ed433d4a3ull;
+static const uint64_t HT_WY_P3 = 0x4d5a2da51de1aa47ull;
+
+/*
+ * Součin 64×64 bitů; do *a uloží dolní a do *b horní polovinu.
+ */
+static inline void ht_mum128(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 ht_uint128_t;
+    ht_uint128_t r = (ht_uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32;
+    uint64_t la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t carry = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+static inline uint64_t ht_mix(uint64_t a, uint64_t b) {
+    ht_mum128(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t ht_read64(const uint8_t *p) {
+    return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 |
+           (uint64_t)p[3] << 24 | (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 |
+           (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+}
+
+static inline uint64_t ht_read32(const uint8_t *p) {
+    return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 |
+           (uint64_t)p[3] << 24;
+}
+
+/*
+ * Původní rozptylovací funkce — součet bajtů klíče.
+ */
+uint64_t ht_hash_additive(const void *data, size_t len, uint64_t seed) {
+    const unsigned char *p = data;
+    uint64_t result = 1 + seed;
+    for (size_t i = 0; i < len; i++) {
+        result += p[i];
+    }
+    return result;
+}
+
+/*
+ * FNV-1a (64 bitů), klíč zpracovává po jednom bajtu.
+ */
+uint64_t ht_hash_fnv1a(const void *data, size_t len, uint64_t seed) {
+    const unsigned char *p = data;
+    uint64_t hash = 14695981039346656037ull ^ seed;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/*
+ * wyhash — klíč zpracovává po 8 bajtech, krátké klíče (do 16 bajtů) pomocí
+ * nejvýše čtyř překrývajících se čtení.
+ */
+uint64_t ht_hash_wy(const void *data, size_t len, uint64_t seed) {
+    const uint8_t *p = data;
+    uint64_t a, b;
+    seed ^= ht_mix(seed ^ HT_WY_P0, HT_WY_P1);
+
+    if (len <= 16) {
+        if (len >= 4) {
+            // Two overlapping 4-byte reads from each end cover 4..16 bytes
+            size_t shift = (len >> 3) << 2;
+            a = (ht_read32(p) << 32) | ht_read32(p + shift);
+            b = (ht_read32(p + len - 4) << 32) | ht_read32(p + len - 4 - shift);
+        } else if (len > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) |
+                p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            // Three independent lanes of 16 bytes keep the multiplier busy
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = ht_mix(ht_read64(p) ^ HT_WY_P1, ht_read64(p + 8) ^ seed);
+                see1 = ht_mix(ht_read64(p + 16) ^ HT_WY_P2,
+                              ht_read64(p + 24) ^ see1);
+                see2 = ht_mix(ht_read64(p + 32) ^ HT_WY_P3,
+                              ht_read64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = ht_mix(ht_read64(p) ^ HT_WY_P1, ht_read64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = ht_read64(p + i - 16);
+        b = ht_read64(p + i - 8);
+    }
+
+    a ^= HT_WY_P1;
+    b ^= seed;
+    ht_mum128(&a, &b);
+    return ht_mix(a ^ HT_WY_P0 ^ len, b ^ HT_WY_P1);
+}
+
+/*
+ * Vrací funkci zvolenou identifikátorem HT_HASH_*, pro neznámý identifikátor
+ * vrací wyhash.
+ */
+ht_hash_fn_t ht_hash_by_id(int id) {
+    switch (id) {
+    case HT_HASH_ADDITIVE:
+        return ht_hash_additive;
+    case HT_HASH_FNV1A:
+        return ht_hash_fnv1a;
+    default:
+        return ht_hash_wy;
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * Hlavičkový soubor pro rozptylovací funkce řetězců.
+ *
+ * Všechny funkce vrací celý 64bitový hash, index řádku si z něj počítá
+ * až konkrétní tabulka. Funkci použitou v get_hash lze zvolit při překladu
+ * makrem HT_TABLE_HASH, funkci rostoucí tabulky makrem HT_HASH, například
+ *   make CFLAGS="-Wall -std=c11 -pedantic -DHT_TABLE_HASH=HT_HASH_WY"
+ */
+
+#ifndef IAL_HT_HASH_H
+#define IAL_HT_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Identifikátory rozptylovacích funkcí pro volbu při překladu
+#define HT_HASH_ADDITIVE 0 // součet bajtů (původní get_hash)
+#define HT_HASH_FNV1A 1    // FNV-1a, po bajtech
+#define HT_HASH_WY 2       // wyhash, po 8 bajtech
+
+// Funkce pro ht_map_t
+#ifndef HT_HASH
+#define HT_HASH HT_HASH_WY
+#endif
+
+// Funkce pro get_hash; výchozí součet bajtů odpovídá výpisům v test.c
+#ifndef HT_TABLE_HASH
+#define HT_TABLE_HASH HT_HASH_ADDITIVE
+#endif
+
+// Semínko pro get_hash (tabulka ht_table_t vlastní semínko nemá)
+#ifndef HT_HASH_SEED
+#define HT_HASH_SEED 0
+#endif
+
+#if HT_HASH == HT_HASH_ADDITIVE
+#define ht_hash_default ht_hash_additive
+#elif HT_HASH == HT_HASH_FNV1A
+#define ht_hash_default ht_hash_fnv1a
+#else
+#define ht_hash_default ht_hash_wy
+#endif
+
+#if HT_TABLE_HASH == HT_HASH_FNV1A
+#define ht_hash_table ht_hash_fnv1a
+#elif HT_TABLE_HASH == HT_HASH_WY
+#define ht_hash_table ht_hash_wy
+#else
+#define ht_hash_table ht_hash_additive
+#endif
+
+typedef uint64_t (*ht_hash_fn_t)(const void *data, size_t len, uint64_t seed);
+
+uint64_t ht_hash_additive(const void *data, size_t len, uint64_t seed);
+uint64_t ht_hash_fnv1a(const void *data, size_t len, uint64_t seed);
+uint64_t ht_hash_wy(const void *data, size_t len, uint64_t seed);
+
+/*
+ * Vrací funkci zvolenou identifikátorem HT_HASH_*.
+ */
+ht_hash_fn_t ht_hash_by_id(int id);
+
+/*
+ * Zúžení 64bitového hashe na 32 bitů tak, aby se zachovaly vyšší bity.
+ */
+static inline unsigned int ht_hash_fold(uint64_t hash) {
+  return (unsigned int)(hash ^ (hash >> 32));
+}
+
+#endif
@@ -0,0 +1,134 @@
+/*
+ * Pomocné funkce pro práci s prvky ht_item_t, sdílené implementacemi
+ * zřetězených tabulek. Není součástí veřejného rozhraní.
+ */
+
+#ifndef IAL_HT_ITEM_H
+#define IAL_HT_ITEM_H
+
+#include "hashtable.h"
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Nejdelší klíč prvku, delší délka se do key_len nevejde
+#define HT_ITEM_MAX_KEY UINT_MAX
+
+/*
+ * Porovnání prvku s klíčem. Bajty klíče se čtou až při shodě celého hashe
+ * i délky, takže při průchodu seznamem synonym se většina prvků odmítne bez
+ * dereference ukazatele na klíč. Délka se porovná v plné šířce size_t,
+ * klíč delší než HT_ITEM_MAX_KEY se tedy neshoduje s žádným prvkem.
+ */
+static inline bool ht_item_matches(const ht_item_t *item, unsigned int hash,
+                                   const char *key, size_t key_len) {
+  return item->hash == hash && item->key_len == key_len &&
+         memcmp(item->key, key, key_len) == 0;
+}
+
+// Počet klíčů, jejichž seznamy synonym se při dávkovém vyhledání
+// procházejí prokládaně
+#define HT_ITEM_BATCH 16
+
+/*
+ * Softwarové přednačtení řádku cache s adresou address (jen nápověda).
+ */
+static inline void ht_item_prefetch(const void *address) {
+#if defined(__GNUC__)
+  __builtin_prefetch(address);
+#else
+  (void)address;
+#endif
+}
+
+/*
+ * Prokládaný průchod nejvýše HT_ITEM_BATCH seznamů synonym.
+ *
+ * cursor[i] je začátek seznamu pro klíč keys[i] s hashem hashes[i] a délkou
+ * lengths[i] (NULL znamená nehledat). Místo jednoho seznamu od začátku do
+ * konce se v každém kole porovná jeden prvek z každého seznamu a přednačte
+ * se jeho následník, takže výpadky cache různých klíčů se překrývají.
+ * Nalezený prvek se zapíše do found[i], u ostatních klíčů se found nemění.
+ */
+static inline void ht_item_walk_batch(ht_item_t **cursor, char **keys,
+                                      const unsigned int *hashes,
+                                      const size_t *lengths,
+                                      size_t count, ht_item_t **found) {
+  bool active = true;
+  while (active) {
+    active = false;
+    for (size_t i = 0; i < count; i++) {
+      ht_item_t *item = cursor[i];
+      if (item == NULL) {
+        continue;
+      }
+      if (ht_item_matches(item, hashes[i], keys[i], lengths[i])) {
+        found[i] = item;
+        cursor[i] = NULL;
+        continue;
+      }
+      cursor[i] = item->next;
+      if (cursor[i] != NULL) {
+        ht_item_prefetch(cursor[i]);
+        active = true;
+      }
+    }
+  }
+}
+
+/*
+ * Velikost bloku paměti pro prvek s klíčem délky key_len.
+ *
+ * Prvek i klíč leží v jednom bloku paměti — klíč následuje hned za
+ * strukturou ht_item_t a item->key ukazuje do stejného bloku. Jedna alokace
+ * na prvek šetří volání malloc i režii alokátoru a při porovnání klíče se
+ * typicky čte stejný nebo sousední řádek cache.
+ */
+static inline size_t ht_item_size(size_t key_len) {
+  return sizeof(ht_item_t) + key_len + 1;
+}
+
+/*
+ * Naplnění prvku v bloku velikosti ht_item_size(key_len) včetně kopie klíče.
+ * Prvek není zařazen do žádného seznamu. Délka key_len nesmí přesáhnout
+ * HT_ITEM_MAX_KEY (viz ht_item_new).
+ */
+static inline ht_item_t *ht_item_init(void *block, const char *key,
+                                      size_t key_len, unsigned int hash,
+                                      float value) {
+  ht_item_t *item = block;
+  item->key = (char *)(item + 1);
+  memcpy(item->key, key, key_len);
+  item->key[key_len] = '\0';
+  item->value = value;
+  item->next = NULL;
+  item->hash = hash;
+  item->key_len = (unsigned int)key_len;
+  return item;
+}
+
+/*
+ * Vytvoření nového prvku s kopií klíče v jednom bloku z malloc.
+ * Při nedostatku paměti nebo pro klíč delší než HT_ITEM_MAX_KEY vrací NULL.
+ */
+static inline ht_item_t *ht_item_new(const char *key, size_t key_len,
+                                     unsigned int hash, float value) {
+  if (key_len > HT_ITEM_MAX_KEY) {
+    return NULL;
+  }
+  void *block = malloc(ht_item_size(key_len));
+  if (block == NULL) {
+    return NULL;
+  }
+  return ht_item_init(block, key, key_len, hash, value);
+}
+
+/*
+ * Uvolnění prvku vytvořeného funkcí ht_item_new (včetně klíče).
+ */
+static inline void ht_item_free(ht_item_t *item) {
+  free(item);
+}
+
+#endif
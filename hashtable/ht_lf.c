@@ -0,0 +1,496 @@
+/*
+ * Tabulka s rozptýlenými položkami, kterou čtou vlákna bez zámků
+ *
+ * Každé vlákno dostane při prvním čtení číslo záznamu epochy, platné pro
+ * všechny tabulky; po skončení vlákna se číslo uvolní. Zapisující vlákna se
+ * drží stejného pravidla jako v ht_conc_t: pole řádků čtou až pod zámkem
+ * pruhu, protože zvětšení drží všechny zámky.
+ */
+
+#include "ht_lf.h"
+#include "ht_hash.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Obsazená čísla záznamů epochy
+static atomic_bool ht_lf_ids[HT_LF_MAX_THREADS];
+
+// Klíč pro uvolnění čísla záznamu při skončení vlákna
+static pthread_key_t ht_lf_id_key;
+static pthread_once_t ht_lf_id_once = PTHREAD_ONCE_INIT;
+
+// Číslo záznamu epochy aktuálního vlákna, -1 dokud ho nemá
+static _Thread_local int ht_lf_id = -1;
+
+static void ht_lf_release_id(void *id) {
+    atomic_store(&ht_lf_ids[(intptr_t)id - 1], false);
+}
+
+static void ht_lf_create_id_key(void) {
+    pthread_key_create(&ht_lf_id_key, ht_lf_release_id);
+}
+
+/*
+ * Číslo záznamu epochy aktuálního vlákna, nebo -1, pokud jsou všechny
+ * záznamy obsazené.
+ */
+static int ht_lf_thread_id(void) {
+    if (ht_lf_id >= 0) {
+        return ht_lf_id;
+    }
+    pthread_once(&ht_lf_id_once, ht_lf_create_id_key);
+    for (int i = 0; i < HT_LF_MAX_THREADS; i++) {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&ht_lf_ids[i], &expected, true)) {
+            // Stored as i + 1, a NULL value would skip the destructor
+            pthread_setspecific(ht_lf_id_key, (void *)(intptr_t)(i + 1));
+            ht_lf_id = i;
+            break;
+        }
+    }
+    return ht_lf_id;
+}
+
+/*
+ * Začátek čtení — oznámí aktuální epochu. Vrací číslo záznamu pro
+ * ht_lf_exit.
+ */
+static int ht_lf_enter(ht_lf_t *table) {
+    int id = ht_lf_thread_id();
+    if (id < 0) {
+        atomic_fetch_add(&table->overflow_readers, 1);
+        return id;
+    }
+    atomic_store_explicit(&table->readers[id].epoch,
+                          2 * atomic_load(&table->epoch) + 1,
+                          memory_order_relaxed);
+    // The bucket loads that follow must not move before the announcement,
+    // pairs with the fence in ht_lf_try_advance
+    atomic_thread_fence(memory_order_seq_cst);
+    return id;
+}
+
+static void ht_lf_exit(ht_lf_t *table, int id) {
+    if (id < 0) {
+        atomic_fetch_sub(&table->overflow_readers, 1);
+    } else {
+        atomic_store_explicit(&table->readers[id].epoch, 0,
+                              memory_order_release);
+    }
+}
+
+static void ht_lf_free_items(ht_lf_item_t *item) {
+    while (item != NULL) {
+        ht_lf_item_t *next = item->retired;
+        free(item);
+        item = next;
+    }
+}
+
+static void ht_lf_free_arrays(ht_lf_array_t *array) {
+    while (array != NULL) {
+        ht_lf_array_t *next = array->retired;
+        free(array);
+        array = next;
+    }
+}
+
+/*
+ * Pokus o posun epochy. Povede se, jen když všechna probíhající čtení
+ * začala v aktuální epoše; pak se uvolní seznam odložený před dvěma
+ * epochami. Volá se pod retire_lock.
+ */
+static void ht_lf_try_advance(ht_lf_t *table) {
+    atomic_thread_fence(memory_order_seq_cst);
+    unsigned int epoch = atomic_load(&table->epoch);
+    if (atomic_load(&table->overflow_readers) > 0) {
+        return;
+    }
+    for (int i = 0; i < HT_LF_MAX_THREADS; i++) {
+        unsigned int reader = atomic_load(&table->readers[i].epoch);
+        if (reader != 0 && reader != 2 * epoch + 1) {
+            return;
+        }
+    }
+    atomic_store(&table->epoch, epoch + 1);
+
+    // Readers are now in epoch or epoch + 1, nothing retired in epoch - 1
+    // or earlier is reachable
+    unsigned int oldest = (epoch + 1) % 3;
+    ht_lf_free_items(table->retired_items[oldest]);
+    ht_lf_free_arrays(table->retired_arrays[oldest]);
+    table->retired_items[oldest] = NULL;
+    table->retired_arrays[oldest] = NULL;
+    table->retired_count = 0;
+}
+
+/*
+ * Odložení seznamu prvků (spojených přes retired) a případně pole řádků
+ * do seznamu aktuální epochy.
+ */
+static void ht_lf_retire(ht_lf_t *table, ht_lf_item_t *first,
+                         ht_lf_item_t *last, size_t count,
+                         ht_lf_array_t *array) {
+    pthread_mutex_lock(&table->retire_lock);
+    unsigned int current = atomic_load(&table->epoch) % 3;
+    if (first != NULL) {
+        last->retired = table->retired_items[current];
+        table->retired_items[current] = first;
+        table->retired_count += count;
+    }
+    if (array != NULL) {
+        array->retired = table->retired_arrays[current];
+        table->retired_arrays[current] = array;
+    }
+    if (table->retired_count >= HT_LF_RETIRE_BATCH || array != NULL) {
+        ht_lf_try_advance(table);
+    }
+    pthread_mutex_unlock(&table->retire_lock);
+}
+
+static ht_lf_array_t *ht_lf_array_new(size_t size) {
+    ht_lf_array_t *array =
+        malloc(sizeof(ht_lf_array_t) + size * sizeof(array->buckets[0]));
+    if (array == NULL) {
+        return NULL;
+    }
+    array->size = size;
+    array->retired = NULL;
+    for (size_t i = 0; i < size; i++) {
+        atomic_init(&array->buckets[i], NULL);
+    }
+    return array;
+}
+
+/*
+ * Nový prvek s kopií klíče. Pro klíč delší než HT_LF_MAX_KEY nebo při
+ * nedostatku paměti vrací NULL.
+ */
+static ht_lf_item_t *ht_lf_item_new(const char *key, size_t key_len,
+                                    unsigned int hash, float value) {
+    if (key_len > HT_LF_MAX_KEY) {
+        return NULL;
+    }
+    ht_lf_item_t *item = malloc(sizeof(ht_lf_item_t) + key_len + 1);
+    if (item == NULL) {
+        return NULL;
+    }
+    atomic_init(&item->next, NULL);
+    atomic_init(&item->value, value);
+    item->hash = hash;
+    item->key_len = (unsigned int)key_len;
+    item->retired = NULL;
+    memcpy(item->key, key, key_len);
+    item->key[key_len] = '\0';
+    return item;
+}
+
+static inline bool ht_lf_matches(const ht_lf_item_t *item, unsigned int hash,
+                                 const char *key, size_t key_len) {
+    return item->hash == hash && item->key_len == key_len &&
+           memcmp(item->key, key, key_len) == 0;
+}
+
+static inline pthread_mutex_t *ht_lf_lock_for(ht_lf_t *table,
+                                              unsigned int hash) {
+    return &table->stripes[hash & (HT_LF_STRIPES - 1)];
+}
+
+static void ht_lf_lock_all(ht_lf_t *table) {
+    for (int i = 0; i < HT_LF_STRIPES; i++) {
+        pthread_mutex_lock(&table->stripes[i]);
+    }
+}
+
+static void ht_lf_unlock_all(ht_lf_t *table) {
+    for (int i = HT_LF_STRIPES - 1; i >= 0; i--) {
+        pthread_mutex_unlock(&table->stripes[i]);
+    }
+}
+
+/*
+ * Zdvojnásobení počtu řádků, pokud ho mezitím nezvětšilo jiné vlákno.
+ *
+ * Prvky se do nového pole kopírují, protože přepojení ukazatelů next by
+ * probíhajícímu čtení ve starém poli mohlo podstrčit jiný seznam. Staré
+ * pole i prvky se odloží. Při nedostatku paměti zůstane tabulka beze změny.
+ */
+static void ht_lf_grow(ht_lf_t *table, size_t seen_size) {
+    ht_lf_lock_all(table);
+    ht_lf_array_t *old = atomic_load_explicit(&table->array,
+                                              memory_order_relaxed);
+    if (old->size != seen_size) {
+        ht_lf_unlock_all(table);
+        return;
+    }
+    ht_lf_array_t *array = ht_lf_array_new(old->size * 2);
+    if (array == NULL) {
+        ht_lf_unlock_all(table);
+        return;
+    }
+
+    ht_lf_item_t *first = NULL, *last = NULL;
+    size_t count = 0;
+    for (size_t i = 0; i < old->size; i++) {
+        ht_lf_item_t *item =
+            atomic_load_explicit(&old->buckets[i], memory_order_relaxed);
+        for (; item != NULL;
+             item = atomic_load_explicit(&item->next, memory_order_relaxed)) {
+            ht_lf_item_t *copy = ht_lf_item_new(
+                item->key, item->key_len, item->hash,
+                atomic_load_explicit(&item->value, memory_order_relaxed));
+            if (copy == NULL) {
+                // Drop the partial copy, the old array stays in place
+                for (size_t j = 0; j < array->size; j++) {
+                    ht_lf_item_t *c = atomic_load_explicit(
+                        &array->buckets[j], memory_order_relaxed);
+                    while (c != NULL) {
+                        ht_lf_item_t *next = atomic_load_explicit(
+                            &c->next, memory_order_relaxed);
+                        free(c);
+                        c = next;
+                    }
+                }
+                free(array);
+                ht_lf_unlock_all(table);
+                return;
+            }
+            _Atomic(ht_lf_item_t *) *bucket =
+                &array->buckets[item->hash & (array->size - 1)];
+            atomic_init(&copy->next,
+                        atomic_load_explicit(bucket, memory_order_relaxed));
+            atomic_init(bucket, copy);
+
+            item->retired = first;
+            first = item;
+            if (last == NULL) {
+                last = item;
+            }
+            count++;
+        }
+    }
+    atomic_store_explicit(&table->array, array, memory_order_release);
+    ht_lf_unlock_all(table);
+    ht_lf_retire(table, first, last, count, old);
+}
+
+/*
+ * Inicializace tabulky — zavolá se před prvním použitím tabulky, dřív než
+ * ji začne používat víc vláken.
+ *
+ * Vrací false, pokud se nepodařilo alokovat pole.
+ */
+bool ht_lf_init(ht_lf_t *table) {
+    ht_lf_array_t *array = ht_lf_array_new(HT_LF_INIT_SIZE);
+    if (array == NULL) {
+        return false;
+    }
+    atomic_init(&table->array, array);
+    atomic_init(&table->count, 0);
+    table->seed = 0;
+    for (int i = 0; i < HT_LF_STRIPES; i++) {
+        pthread_mutex_init(&table->stripes[i], NULL);
+    }
+    for (int i = 0; i < HT_LF_MAX_THREADS; i++) {
+        atomic_init(&table->readers[i].epoch, 0);
+    }
+    atomic_init(&table->overflow_readers, 0);
+    atomic_init(&table->epoch, 0);
+    pthread_mutex_init(&table->retire_lock, NULL);
+    for (int i = 0; i < 3; i++) {
+        table->retired_items[i] = NULL;
+        table->retired_arrays[i] = NULL;
+    }
+    table->retired_count = 0;
+    return true;
+}
+
+/*
+ * Zápis hodnoty prvku pod zámkem jeho pruhu.
+ *
+ * Existující prvek dostane atomicky hodnotu value, nebo se k ní value
+ * přičte (add). Chybějící prvek se nejdřív celý naplní a teprve
+ * pak se zveřejní zápisem na začátek seznamu, takže čtení nikdy neuvidí
+ * nehotový prvek. Klíč delší než HT_LF_MAX_KEY se nevloží.
+ */
+static void ht_lf_put(ht_lf_t *table, char *key, float value, bool add) {
+    size_t length = strlen(key);
+    if (length > HT_LF_MAX_KEY) {
+        return;
+    }
+    unsigned int hash = ht_hash_fold(ht_hash_default(key, length, table->seed));
+    pthread_mutex_t *lock = ht_lf_lock_for(table, hash);
+
+    pthread_mutex_lock(lock);
+    ht_lf_array_t *array =
+        atomic_load_explicit(&table->array, memory_order_relaxed);
+    _Atomic(ht_lf_item_t *) *bucket = &array->buckets[hash & (array->size - 1)];
+    ht_lf_item_t *head = atomic_load_explicit(bucket, memory_order_relaxed);
+    for (ht_lf_item_t *item = head; item != NULL;
+         item = atomic_load_explicit(&item->next, memory_order_relaxed)) {
+        if (ht_lf_matches(item, hash, key, length)) {
+            // Writers of one key are serialized by the stripe lock, so
+            // load + store is an atomic add as far as readers can tell
+            if (add) {
+                value += atomic_load_explicit(&item->value,
+                                              memory_order_relaxed);
+            }
+            atomic_store_explicit(&item->value, value, memory_order_relaxed);
+            pthread_mutex_unlock(lock);
+            return;
+        }
+    }
+    ht_lf_item_t *item = ht_lf_item_new(key, length, hash, value);
+    if (item == NULL) {
+        pthread_mutex_unlock(lock);
+        return;
+    }
+    atomic_init(&item->next, head);
+    atomic_store_explicit(bucket, item, memory_order_release);
+    size_t size = array->size;
+    pthread_mutex_unlock(lock);
+
+    size_t count = atomic_fetch_add(&table->count, 1) + 1;
+    if (count > size * HT_LF_MAX_LOAD) {
+        ht_lf_grow(table, size);
+    }
+}
+
+/*
+ * Vložení nového prvku do tabulky.
+ *
+ * Pokud prvek s daným klíčem už v tabulce existuje, nahradí se atomicky
+ * jeho hodnota.
+ */
+void ht_lf_insert(ht_lf_t *table, char *key, float value) {
+    ht_lf_put(table, key, value, false);
+}
+
+/*
+ * Přičtení delta k hodnotě prvku jedním vyhledáním, chybějící prvek se
+ * vloží s hodnotou delta. Hodnota se mění atomicky, takže ji čtení bez
+ * zámku vidí vždy celou.
+ */
+void ht_lf_add(ht_lf_t *table, char *key, float delta) {
+    ht_lf_put(table, key, delta, true);
+}
+
+/*
+ * Získání hodnoty z tabulky bez zámku.
+ *
+ * V případě úspěchu zapíše hodnotu prvku do *value a vrací true, v opačném
+ * případě vrací false a *value nemění.
+ */
+bool ht_lf_get(ht_lf_t *table, char *key, float *value) {
+    size_t length = strlen(key);
+    if (length > HT_LF_MAX_KEY) {
+        return false;
+    }
+    unsigned int hash = ht_hash_fold(ht_hash_default(key, length, table->seed));
+    int id = ht_lf_enter(table);
+
+    ht_lf_array_t *array =
+        atomic_load_explicit(&table->array, memory_order_acquire);
+    ht_lf_item_t *item = atomic_load_explicit(
+        &array->buckets[hash & (array->size - 1)], memory_order_acquire);
+    while (item != NULL && !ht_lf_matches(item, hash, key, length)) {
+        item = atomic_load_explicit(&item->next, memory_order_acquire);
+    }
+    if (item != NULL) {
+        *value = atomic_load_explicit(&item->value, memory_order_relaxed);
+    }
+
+    ht_lf_exit(table, id);
+    return item != NULL;
+}
+
+/*
+ * Smazání prvku z tabulky. Prvek se vyřadí ze seznamu hned, uvolní se až
+ * ve chvíli, kdy ho žádné čtení nemůže vidět.
+ */
+void ht_lf_delete(ht_lf_t *table, char *key) {
+    size_t length = strlen(key);
+    if (length > HT_LF_MAX_KEY) {
+        return;
+    }
+    unsigned int hash = ht_hash_fold(ht_hash_default(key, length, table->seed));
+    pthread_mutex_t *lock = ht_lf_lock_for(table, hash);
+
+    pthread_mutex_lock(lock);
+    ht_lf_array_t *array =
+        atomic_load_explicit(&table->array, memory_order_relaxed);
+    _Atomic(ht_lf_item_t *) *link = &array->buckets[hash & (array->size - 1)];
+    ht_lf_item_t *item = atomic_load_explicit(link, memory_order_relaxed);
+    while (item != NULL && !ht_lf_matches(item, hash, key, length)) {
+        link = &item->next;
+        item = atomic_load_explicit(link, memory_order_relaxed);
+    }
+    if (item != NULL) {
+        // Readers standing on item still see a valid next pointer
+        atomic_store_explicit(
+            link, atomic_load_explicit(&item->next, memory_order_relaxed),
+            memory_order_release);
+    }
+    pthread_mutex_unlock(lock);
+
+    if (item != NULL) {
+        atomic_fetch_sub(&table->count, 1);
+        ht_lf_retire(table, item, item, 1, NULL);
+    }
+}
+
+/*
+ * Smazání všech prvků z tabulky. Drží všechny zámky zapisujících vláken,
+ * čtení může běžet dál. Počet řádků se zachová.
+ */
+void ht_lf_delete_all(ht_lf_t *table) {
+    ht_lf_lock_all(table);
+    ht_lf_array_t *array =
+        atomic_load_explicit(&table->array, memory_order_relaxed);
+    ht_lf_item_t *first = NULL, *last = NULL;
+    size_t count = 0;
+    for (size_t i = 0; i < array->size; i++) {
+        ht_lf_item_t *item =
+            atomic_exchange_explicit(&array->buckets[i], NULL,
+                                     memory_order_acq_rel);
+        for (; item != NULL;
+             item = atomic_load_explicit(&item->next, memory_order_relaxed)) {
+            item->retired = first;
+            first = item;
+            if (last == NULL) {
+                last = item;
+            }
+            count++;
+        }
+    }
+    atomic_store(&table->count, 0);
+    ht_lf_unlock_all(table);
+    ht_lf_retire(table, first, last, count, NULL);
+}
+
+/*
+ * Zrušení tabulky — zavolá se, až ji žádné vlákno nepoužívá. Uvolní
+ * všechny prvky včetně odložených.
+ */
+void ht_lf_destroy(ht_lf_t *table) {
+    ht_lf_delete_all(table);
+    for (int i = 0; i < 3; i++) {
+        ht_lf_free_items(table->retired_items[i]);
+        ht_lf_free_arrays(table->retired_arrays[i]);
+        table->retired_items[i] = NULL;
+        table->retired_arrays[i] = NULL;
+    }
+    free(atomic_load(&table->array));
+    atomic_store(&table->array, NULL);
+    for (int i = 0; i < HT_LF_STRIPES; i++) {
+        pthread_mutex_destroy(&table->stripes[i]);
+    }
+    pthread_mutex_destroy(&table->retire_lock);
+}
+
+/*
+ * Počet prvků v tabulce. Při souběžných změnách jde o okamžitý odhad.
+ */
+size_t ht_lf_count(ht_lf_t *table) {
+    return atomic_load(&table->count);
+}
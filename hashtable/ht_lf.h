@@ -0,0 +1,92 @@
+/*
+ * Hlavičkový soubor pro tabulku s rozptýlenými položkami, kterou čtou
+ * vlákna bez zámků.
+ *
+ * Zapisující vlákna se zamykají po pruzích stejně jako v ht_conc_t a nové
+ * prvky zveřejňují atomickým zápisem ukazatele na začátek seznamu. Čtení
+ * (ht_lf_get) nebere žádný zámek a nikdy nečeká na zapisující vlákno.
+ *
+ * Smazaný prvek nejde uvolnit hned, protože ho ještě může procházet čtoucí
+ * vlákno. Uvolňuje se až podle epoch (epoch-based reclamation): čtení
+ * oznámí globální epochu, ve které začalo; smazaný prvek se odloží do
+ * seznamu aktuální epochy a uvolní se, až epocha postoupí o dvě dál, tedy
+ * až žádné čtení nemůže prvek vidět. Zvětšení tabulky prvky zkopíruje do
+ * nového pole a staré pole i prvky odloží stejným způsobem.
+ */
+
+#ifndef IAL_HT_LF_H
+#define IAL_HT_LF_H
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Počet zámků zapisujících vláken (mocnina dvou)
+#define HT_LF_STRIPES 64
+
+// Počáteční počet řádků (mocnina dvou, násobek HT_LF_STRIPES)
+#define HT_LF_INIT_SIZE 1024
+
+// Maximální průměrný počet prvků na řádek před zvětšením tabulky
+#define HT_LF_MAX_LOAD 1
+
+// Maximální počet současně běžících vláken s vlastním záznamem epochy;
+// další vlákna čtou přes společný čítač a jen zdržují uvolňování
+#define HT_LF_MAX_THREADS 128
+
+// Počet odložených prvků, po kterém se zkusí posunout epocha
+#define HT_LF_RETIRE_BATCH 64
+
+// Nejdelší klíč, jehož délka se vejde do key_len; delší se nevloží
+#define HT_LF_MAX_KEY UINT_MAX
+
+// Prvek tabulky, klíč leží ve stejném bloku paměti
+typedef struct ht_lf_item {
+  _Atomic(struct ht_lf_item *) next; // další prvek seznamu synonym
+  _Atomic float value;               // hodnota prvku
+  unsigned int hash;                 // celý hash klíče
+  unsigned int key_len;              // délka klíče
+  struct ht_lf_item *retired;        // další odložený prvek
+  char key[];                        // klíč ukončený nulou
+} ht_lf_item_t;
+
+// Pole řádků, po zvětšení se nahradí celé
+typedef struct ht_lf_array {
+  size_t size;                       // počet řádků (mocnina dvou)
+  struct ht_lf_array *retired;       // další odložené pole
+  _Atomic(ht_lf_item_t *) buckets[]; // začátky seznamů synonym
+} ht_lf_array_t;
+
+// Záznam epochy jednoho vlákna, každý na vlastním řádku cache
+typedef struct ht_lf_reader {
+  _Alignas(64) atomic_uint epoch; // 0 mimo čtení, jinak 2 * epocha + 1
+} ht_lf_reader_t;
+
+// Tabulka
+typedef struct ht_lf {
+  _Atomic(ht_lf_array_t *) array;            // aktuální pole řádků
+  atomic_size_t count;                       // počet prvků
+  uint64_t seed;                             // semínko rozptylovací funkce
+  pthread_mutex_t stripes[HT_LF_STRIPES];    // zámky zapisujících vláken
+  ht_lf_reader_t readers[HT_LF_MAX_THREADS]; // epochy čtoucích vláken
+  atomic_uint overflow_readers;              // čtení bez vlastního záznamu
+  atomic_uint epoch;                         // globální epocha
+  pthread_mutex_t retire_lock;               // zámek odložených seznamů
+  ht_lf_item_t *retired_items[3];            // odložené prvky podle epochy
+  ht_lf_array_t *retired_arrays[3];          // odložená pole podle epochy
+  size_t retired_count;                      // odloženo od posunu epochy
+} ht_lf_t;
+
+bool ht_lf_init(ht_lf_t *table);
+void ht_lf_insert(ht_lf_t *table, char *key, float value);
+void ht_lf_add(ht_lf_t *table, char *key, float delta);
+bool ht_lf_get(ht_lf_t *table, char *key, float *value);
+void ht_lf_delete(ht_lf_t *table, char *key);
+void ht_lf_delete_all(ht_lf_t *table);
+void ht_lf_destroy(ht_lf_t *table);
+size_t ht_lf_count(ht_lf_t *table);
+
+#endif
@@ -0,0 +1,180 @@
+/*
+ * Hromadné načtení slov ze souboru do tabulky
+ *
+ * Hranice úseků se posouvají dopředu na nejbližší bílý znak, takže žádné
+ * slovo nepatří do dvou úseků. Slova se vkládají přímo jako úseky
+ * namapovaného souboru s délkou (ht_shard_add_n), bez kopírování a bez
+ * ukončovací nuly; kopii klíče si udělá až nový prvek tabulky.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ht_load.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Úsek dat pro jedno vlákno
+typedef struct ht_load_job {
+  pthread_t thread;   // vlákno zpracovávající úsek
+  bool started;       // vlákno bylo spuštěno
+  const char *begin;  // začátek úseku
+  const char *end;    // konec úseku
+  ht_shard_t *shard;  // tabulka vlákna
+  size_t words;       // počet slov vložených do tabulky
+  bool failed;        // vložení slova selhalo pro nedostatek paměti
+} ht_load_job_t;
+
+// Bílé znaky podle isspace v locale "C"
+static inline bool ht_load_space(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/*
+ * Rozdělení úseku na slova a jejich započítání do tabulky vlákna. Při
+ * nedostatku paměti nastaví failed a zbytek úseku přeskočí.
+ */
+static void *ht_load_chunk(void *arg) {
+    ht_load_job_t *job = arg;
+    const char *p = job->begin;
+    while (p < job->end) {
+        while (p < job->end && ht_load_space(*p)) {
+            p++;
+        }
+        const char *word = p;
+        while (p < job->end && !ht_load_space(*p) &&
+               p - word < HT_LOAD_MAX_WORD - 1) {
+            p++;
+        }
+        if (p == word) {
+            break;
+        }
+        if (ht_shard_add_n(job->shard, word, (size_t)(p - word), 1.0) == NULL) {
+            job->failed = true;
+            break;
+        }
+        job->words++;
+    }
+    return NULL;
+}
+
+/*
+ * Načtení slov z paměti data o velikosti size do tabulky dest pomocí
+ * threads vláken. Hodnota prvku se zvýší o počet výskytů slova, tabulka
+ * dest musí mít výchozí semínko. Počet načtených slov zapíše do *words.
+ * Vrací false při nedostatku paměti (tabulka dest pak může být načtená jen
+ * zčásti). První úsek se počítá přímo do dest, ostatní do vlastních tabulek
+ * sečtených na konci.
+ */
+bool ht_load_buffer(ht_shard_t *dest, const char *data, size_t size,
+                    unsigned int threads, size_t *words) {
+    if (threads == 0) {
+        threads = 1;
+    }
+    // Tiny inputs are not worth a thread per chunk
+    if (threads > size / HT_LOAD_MAX_WORD + 1) {
+        threads = size / HT_LOAD_MAX_WORD + 1;
+    }
+    // The first chunk counts straight into dest, the others into their
+    // own tables that are summed into dest at the end
+    ht_load_job_t *jobs = malloc(threads * sizeof(ht_load_job_t));
+    ht_shard_t *shards = malloc(threads * sizeof(ht_shard_t));
+    unsigned int ready = 1;
+    while (jobs != NULL && shards != NULL && ready < threads &&
+           ht_shard_init(&shards[ready])) {
+        ready++;
+    }
+    if (jobs == NULL || shards == NULL || ready < threads) {
+        while (ready > 1) {
+            ht_shard_destroy(&shards[--ready]);
+        }
+        free(jobs);
+        free(shards);
+        return false;
+    }
+
+    const char *end = data + size;
+    const char *begin = data;
+    for (unsigned int t = 0; t < threads; t++) {
+        const char *split =
+            t + 1 == threads ? end : data + size / threads * (t + 1);
+        if (split < begin) {
+            split = begin;
+        }
+        while (split < end && !ht_load_space(*split)) {
+            split++;
+        }
+        jobs[t] = (ht_load_job_t){.begin = begin, .end = split,
+                                  .shard = t == 0 ? dest : &shards[t]};
+        begin = split;
+    }
+
+    // The first chunk runs on the calling thread, as do chunks whose
+    // thread could not be started
+    for (unsigned int t = 1; t < threads; t++) {
+        jobs[t].started =
+            pthread_create(&jobs[t].thread, NULL, ht_load_chunk, &jobs[t]) == 0;
+    }
+    bool loaded = true;
+    *words = 0;
+    for (unsigned int t = 0; t < threads; t++) {
+        if (jobs[t].started) {
+            pthread_join(jobs[t].thread, NULL);
+        } else {
+            ht_load_chunk(&jobs[t]);
+        }
+        *words += jobs[t].words;
+        loaded = loaded && !jobs[t].failed;
+    }
+
+    if (threads > 1) {
+        loaded = ht_shard_merge(dest, shards + 1, threads - 1, ht_shard_sum,
+                                threads - 1) &&
+                 loaded;
+    }
+    for (unsigned int t = 1; t < threads; t++) {
+        ht_shard_destroy(&shards[t]);
+    }
+    free(shards);
+    free(jobs);
+    return loaded;
+}
+
+/*
+ * Načtení všech slov ze souboru path do tabulky dest pomocí threads vláken.
+ *
+ * Hodnota prvku se zvýší o počet výskytů slova. Počet načtených slov
+ * zapíše do *words. Vrací false, pokud soubor nejde otevřít nebo namapovat,
+ * nebo při nedostatku paměti (tabulka dest pak může být načtená jen zčásti).
+ */
+bool ht_load_file(ht_shard_t *dest, const char *path, unsigned int threads,
+                  size_t *words) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        *words = 0;
+        return true;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+    bool loaded = ht_load_buffer(dest, data, size, threads, words);
+    munmap(data, size);
+    return loaded;
+}
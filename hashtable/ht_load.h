@@ -0,0 +1,25 @@
+/*
+ * Hlavičkový soubor pro hromadné načtení slov ze souboru do tabulky.
+ *
+ * Soubor se namapuje do paměti (mmap), rozdělí se na úseky na hranicích
+ * bílých znaků a úseky se rozdělí slova paralelně — každé vlákno počítá
+ * výskyty slov do vlastní ht_shard_t a na konci se tabulky sečtou do
+ * cílové funkcí ht_shard_merge. Hodnota prvku je počet výskytů slova.
+ */
+
+#ifndef IAL_HT_LOAD_H
+#define IAL_HT_LOAD_H
+
+#include "ht_shard.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Maximální délka slova, delší slovo se rozdělí (jako read_word v test_muj.c)
+#define HT_LOAD_MAX_WORD 1024
+
+bool ht_load_file(ht_shard_t *dest, const char *path, unsigned int threads,
+                  size_t *words);
+bool ht_load_buffer(ht_shard_t *dest, const char *data, size_t size,
+                    unsigned int threads, size_t *words);
+
+#endif
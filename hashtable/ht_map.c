@@ -0,0 +1,836 @@
+/*
+ * Rostoucí tabulka s rozptýlenými položkami
+ *
+ * Tabulka s explicitně zřetězenými synonymy, která se při zaplnění zvětšuje.
+ * Přesun položek do nového pole probíhá inkrementálně, takže žádná jednotlivá
+ * operace nezaplatí celou cenu přehashování O(n).
+ */
+
+#include "ht_map.h"
+#include "ht_hash.h"
+#include "ht_item.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Rozptylovací funkce vracející celý (neoříznutý) hash klíče délky length
+ * se semínkem tabulky. Index řádku se z něj počítá až podle velikosti
+ * konkrétního pole.
+ */
+static unsigned int ht_map_hash_n(ht_map_t *map, const char *key,
+                                  size_t length) {
+    return ht_hash_fold(ht_hash_default(key, length, map->seed));
+}
+
+/*
+ * Hash klíče ukončeného nulou, do *length uloží délku klíče.
+ */
+static unsigned int ht_map_hash(ht_map_t *map, char *key, size_t *length) {
+    *length = strlen(key);
+    return ht_map_hash_n(map, key, *length);
+}
+
+/*
+ * Index řádku v poli velikosti size. Prvočíselná pole (shift == 0) berou
+ * zbytek po dělení; pole o velikosti 2^k mají shift = 64 - k a berou horních
+ * k bitů součinu hashe se zlatým řezem 2^64 (Fibonacciho hashování), takže
+ * místo dělení stačí násobení a posun a do indexu promluví všechny bity
+ * hashe, nejen ty dolní.
+ */
+static inline size_t ht_map_index(unsigned int hash, size_t size,
+                                  unsigned int shift) {
+    if (shift != 0) {
+        return (size_t)((hash * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+    return hash % size;
+}
+
+/*
+ * Vrátí nejmenší prvočíslo větší nebo rovné n.
+ */
+static size_t ht_map_next_prime(size_t n) {
+    if (n <= 2) {
+        return 2;
+    }
+    if (n % 2 == 0) {
+        n++;
+    }
+    for (;; n += 2) {
+        bool prime = true;
+        for (size_t d = 3; d * d <= n; d += 2) {
+            if (n % d == 0) {
+                prime = false;
+                break;
+            }
+        }
+        if (prime) {
+            return n;
+        }
+    }
+}
+
+/*
+ * Přesune jeden řádek starého pole do aktuálního pole.
+ */
+static void ht_map_migrate_bucket(ht_map_t *map, size_t index) {
+    ht_item_t *item = map->old_buckets[index];
+    while (item != NULL) {
+        ht_item_t *next = item->next;
+        // Relink the item at the head of its chain in the new array, the
+        // cached hash saves rehashing the key
+        size_t target = ht_map_index(item->hash, map->size, map->shift);
+        item->next = map->buckets[target];
+        map->buckets[target] = item;
+        item = next;
+    }
+    map->old_buckets[index] = NULL;
+}
+
+/*
+ * Provede jeden krok přesouvání — přesune nejvýše HT_MAP_REHASH_STEP řádků.
+ * Po přesunutí posledního řádku staré pole uvolní.
+ */
+static void ht_map_migrate_step(ht_map_t *map, size_t steps) {
+    if (map->old_buckets == NULL) {
+        return;
+    }
+    while (steps > 0 && map->migrate_pos < map->old_size) {
+        ht_map_migrate_bucket(map, map->migrate_pos);
+        map->migrate_pos++;
+        steps--;
+    }
+    if (map->migrate_pos == map->old_size) {
+        free(map->old_buckets);
+        map->old_buckets = NULL;
+        map->old_size = 0;
+        map->old_shift = 0;
+        map->migrate_pos = 0;
+    }
+}
+
+/*
+ * Zahájí zvětšení tabulky, pokud byla překročena maximální zaplněnost.
+ * Případné předchozí přesouvání se nejprve dokončí.
+ */
+static void ht_map_maybe_grow(ht_map_t *map) {
+    if (map->count <= map->size * HT_MAP_MAX_LOAD) {
+        return;
+    }
+    // Finish the previous migration, there is only room for one old array
+    ht_map_migrate_step(map, map->old_size);
+
+    // A power-of-two array doubles and takes one more bit of the product
+    size_t new_size =
+        map->shift != 0 ? map->size * 2 : ht_map_next_prime(map->size * 2 + 1);
+    ht_item_t **new_buckets = calloc(new_size, sizeof(ht_item_t *));
+    if (new_buckets == NULL) {
+        // Keep working with longer chains when the allocation fails
+        return;
+    }
+    map->old_buckets = map->buckets;
+    map->old_size = map->size;
+    map->old_shift = map->shift;
+    map->migrate_pos = 0;
+    map->buckets = new_buckets;
+    map->size = new_size;
+    if (map->shift != 0) {
+        map->shift--;
+    }
+}
+
+/*
+ * Alokace nového prvku z arény tabulky nebo pomocí malloc. Pro klíč delší
+ * než HT_ITEM_MAX_KEY vrací NULL.
+ */
+static ht_item_t *ht_map_item_new(ht_map_t *map, const char *key,
+                                  size_t length, unsigned int hash,
+                                  float value) {
+    if (length > HT_ITEM_MAX_KEY) {
+        return NULL;
+    }
+    if (map->arena == NULL) {
+        return ht_item_new(key, length, hash, value);
+    }
+    void *block = ht_arena_alloc(map->arena, ht_item_size(length));
+    if (block == NULL) {
+        return NULL;
+    }
+    return ht_item_init(block, key, length, hash, value);
+}
+
+/*
+ * Uvolnění prvku — v arénovém režimu se jeho paměť vrátí k dalšímu použití.
+ */
+static void ht_map_item_free(ht_map_t *map, ht_item_t *item) {
+    if (map->arena == NULL) {
+        ht_item_free(item);
+    } else {
+        ht_arena_release(map->arena, item, ht_item_size(item->key_len));
+    }
+}
+
+/*
+ * Inicializace tabulky s polem velikosti size a posunem shift (viz
+ * ht_map_index).
+ */
+static bool ht_map_init_sized(ht_map_t *map, uint64_t seed, size_t size,
+                              unsigned int shift) {
+    map->seed = seed;
+    map->arena = NULL;
+    map->bloom = NULL;
+    map->buckets = calloc(size, sizeof(ht_item_t *));
+    map->size = map->buckets != NULL ? size : 0;
+    map->shift = shift;
+    map->old_buckets = NULL;
+    map->old_size = 0;
+    map->old_shift = 0;
+    map->migrate_pos = 0;
+    map->count = 0;
+    return map->buckets != NULL;
+}
+
+/*
+ * Inicializace tabulky se zadaným semínkem rozptylovací funkce.
+ *
+ * Vrací false, pokud se nepodařilo alokovat pole.
+ */
+bool ht_map_init_seeded(ht_map_t *map, uint64_t seed) {
+    return ht_map_init_sized(map, seed, HT_MAP_INIT_SIZE, 0);
+}
+
+/*
+ * Inicializace tabulky, jejíž pole má vždy velikost mocniny dvojky.
+ *
+ * Index řádku se místo zbytku po dělení prvočíslem počítá násobením
+ * a posunem (viz ht_map_index), tabulka se zvětšuje na dvojnásobek.
+ * Ostatní funkce se chovají stejně. Vrací false, pokud se nepodařilo
+ * alokovat pole.
+ */
+bool ht_map_init_pow2(ht_map_t *map) {
+    return ht_map_init_sized(map, 0, (size_t)1 << HT_MAP_INIT_BITS,
+                             64 - HT_MAP_INIT_BITS);
+}
+
+/*
+ * Inicializace tabulky — zavolá se před prvním použitím tabulky.
+ *
+ * Vrací false, pokud se nepodařilo alokovat pole.
+ */
+bool ht_map_init(ht_map_t *map) {
+    return ht_map_init_seeded(map, 0);
+}
+
+/*
+ * Inicializace tabulky, jejíž prvky se přidělují z vlastní arény.
+ *
+ * Smazané prvky se recyklují přes seznamy volných úseků arény
+ * a ht_map_delete_all místo uvolňování jednotlivých prvků jen vyprázdní
+ * arénu a vynuluje pole seznamů synonym. Vrací false při nedostatku paměti.
+ */
+bool ht_map_init_arena(ht_map_t *map) {
+    if (!ht_map_init(map)) {
+        return false;
+    }
+    map->arena = malloc(sizeof(ht_arena_t));
+    if (map->arena == NULL) {
+        ht_map_destroy(map);
+        return false;
+    }
+    ht_arena_init(map->arena);
+    return true;
+}
+
+/*
+ * Vypnutí a uvolnění Bloomova filtru.
+ */
+void ht_map_bloom_disable(ht_map_t *map) {
+    if (map->bloom != NULL) {
+        ht_bloom_destroy(map->bloom);
+        free(map->bloom);
+        map->bloom = NULL;
+    }
+}
+
+/*
+ * Sestavení nového filtru pro capacity klíčů ze všech prvků tabulky.
+ * Při nedostatku paměti vrací false a dosavadní filtr ponechá.
+ */
+static bool ht_map_bloom_fill(ht_map_t *map, size_t capacity) {
+    ht_bloom_t *bloom = malloc(sizeof(ht_bloom_t));
+    if (bloom == NULL) {
+        return false;
+    }
+    if (!ht_bloom_init(bloom, capacity > map->count ? capacity : map->count)) {
+        free(bloom);
+        return false;
+    }
+    for (size_t i = 0; i < map->size; i++) {
+        for (ht_item_t *item = map->buckets[i]; item != NULL;
+             item = item->next) {
+            ht_bloom_add(bloom, item->hash);
+        }
+    }
+    // Migrated rows of the old array are already empty
+    for (size_t i = 0; i < map->old_size; i++) {
+        for (ht_item_t *item = map->old_buckets[i]; item != NULL;
+             item = item->next) {
+            ht_bloom_add(bloom, item->hash);
+        }
+    }
+    ht_map_bloom_disable(map);
+    map->bloom = bloom;
+    return true;
+}
+
+/*
+ * Zapnutí Bloomova filtru dimenzovaného na expected klíčů (nejméně na
+ * současný počet prvků).
+ *
+ * Filtr se udržuje při každém vložení; když počet prvků překročí jeho
+ * kapacitu, sestaví se znovu pro dvojnásobek. Smazané klíče ve filtru
+ * zůstávají, po smazání velké části tabulky je vhodné zavolat
+ * ht_map_bloom_rebuild. Je-li filtr už zapnutý, sestaví se znovu. Vrací
+ * false při nedostatku paměti.
+ *
+ * Nalezení existujícího klíče pak stojí čtení bloku filtru navíc, filtr se
+ * vyplatí hlavně tam, kde většina dotazů hledá chybějící klíče.
+ */
+bool ht_map_bloom_enable(ht_map_t *map, size_t expected) {
+    return ht_map_bloom_fill(map, expected);
+}
+
+/*
+ * Nové sestavení filtru jen z prvků, které v tabulce jsou, se stejnou
+ * kapacitou. Vrací false, pokud filtr není zapnutý nebo chybí paměť.
+ */
+bool ht_map_bloom_rebuild(ht_map_t *map) {
+    if (map->bloom == NULL) {
+        return false;
+    }
+    return ht_map_bloom_fill(map, map->bloom->capacity);
+}
+
+/*
+ * Vyhledání prvku v seznamu synonym.
+ */
+static ht_item_t *ht_map_chain_search(ht_item_t *item, unsigned int hash,
+                                      const char *key, size_t length) {
+    while (item != NULL) {
+        if (ht_item_matches(item, hash, key, length)) {
+            return item;
+        }
+        item = item->next;
+    }
+    return NULL;
+}
+
+/*
+ * Vyhledání prvku podle již spočítaného hashe a délky klíče.
+ */
+static ht_item_t *ht_map_find(ht_map_t *map, unsigned int hash,
+                              const char *key, size_t length) {
+    if (map->bloom != NULL && !ht_bloom_may_contain(map->bloom, hash)) {
+        return NULL;
+    }
+    ht_item_t *item =
+        ht_map_chain_search(
+        map->buckets[ht_map_index(hash, map->size, map->shift)], hash, key,
+        length);
+    if (item == NULL && map->old_buckets != NULL) {
+        size_t old_index = ht_map_index(hash, map->old_size, map->old_shift);
+        if (old_index >= map->migrate_pos) {
+            item = ht_map_chain_search(map->old_buckets[old_index], hash, key,
+                                       length);
+        }
+    }
+    return item;
+}
+
+/*
+ * Vyhledání prvku v tabulce.
+ *
+ * Během přesouvání se prohledá aktuální pole a řádek starého pole, pokud ještě
+ * nebyl přesunut. V případě úspěchu vrací ukazatel na nalezený prvek;
+ * v opačném případě vrací hodnotu NULL.
+ */
+ht_item_t *ht_map_search(ht_map_t *map, char *key) {
+    return ht_map_search_n(map, key, strlen(key));
+}
+
+/*
+ * Vyhledání prvku s klíčem key délky length, viz ht_map_search.
+ *
+ * Klíč nemusí být ukončený nulou (např. úsek namapovaného souboru).
+ */
+ht_item_t *ht_map_search_n(ht_map_t *map, const char *key, size_t length) {
+    if (map->size == 0 || length > HT_ITEM_MAX_KEY) {
+        return NULL;
+    }
+    return ht_map_find(map, ht_map_hash_n(map, key, length), key, length);
+}
+
+/*
+ * Zařazení prvku na začátek seznamu v aktuálním poli.
+ */
+static void ht_map_link(ht_map_t *map, ht_item_t *item) {
+    size_t index = ht_map_index(item->hash, map->size, map->shift);
+    item->next = map->buckets[index];
+    map->buckets[index] = item;
+    map->count++;
+    if (map->bloom != NULL) {
+        ht_bloom_add(map->bloom, item->hash);
+        if (map->count > map->bloom->capacity) {
+            // An overfull filter stays correct, it only answers "maybe"
+            // more often, so a failed rebuild keeps the old one
+            ht_map_bloom_fill(map, map->count * 2);
+        }
+    }
+    ht_map_maybe_grow(map);
+}
+
+/*
+ * Hash klíče se semínkem tabulky, jaký používají funkce *_hashed. Do
+ * *length uloží délku klíče.
+ */
+unsigned int ht_map_key_hash(ht_map_t *map, char *key, size_t *length) {
+    *length = strlen(key);
+    return ht_map_hash_n(map, key, *length);
+}
+
+/*
+ * Hash klíče key délky length, který nemusí být ukončený nulou, viz
+ * ht_map_key_hash.
+ */
+unsigned int ht_map_key_hash_n(ht_map_t *map, const char *key,
+                               size_t length) {
+    return ht_map_hash_n(map, key, length);
+}
+
+/*
+ * Vyhledání prvku podle hashe a délky klíče spočítaných dříve funkcí
+ * ht_map_key_hash, například když je volající potřeboval i pro jiný účel.
+ * Klíč delší než HT_ITEM_MAX_KEY v tabulce být nemůže (vrací NULL).
+ */
+ht_item_t *ht_map_search_hashed(ht_map_t *map, const char *key,
+                                size_t length, unsigned int hash) {
+    if (map->size == 0 || length > HT_ITEM_MAX_KEY) {
+        return NULL;
+    }
+    return ht_map_find(map, hash, key, length);
+}
+
+/*
+ * Vložení nebo nalezení prvku podle hashe a délky klíče spočítaných dříve
+ * funkcí ht_map_key_hash. Chová se stejně jako ht_map_upsert_n, klíč delší
+ * než HT_ITEM_MAX_KEY se nevloží (vrací NULL).
+ */
+float *ht_map_upsert_hashed(ht_map_t *map, const char *key, size_t length,
+                            unsigned int hash, float value) {
+    if (map->size == 0 || length > HT_ITEM_MAX_KEY) {
+        return NULL;
+    }
+    ht_map_migrate_step(map, HT_MAP_REHASH_STEP);
+
+    // Check if key already exists in either of the arrays
+    ht_item_t *existingItem = ht_map_find(map, hash, key, length);
+    if (existingItem != NULL) {
+        return &existingItem->value;
+    }
+
+    ht_item_t *newItem = ht_map_item_new(map, key, length, hash, value);
+    if (newItem == NULL) {
+        return NULL;
+    }
+    ht_map_link(map, newItem);
+    return &newItem->value;
+}
+
+/*
+ * Vložení nebo nalezení prvku jedním výpočtem hashe a jedním průchodem.
+ *
+ * Pokud prvek s daným klíčem v tabulce existuje, vrací ukazatel na jeho
+ * hodnotu beze změny, jinak vloží nový prvek s hodnotou value na začátek
+ * seznamu v aktuálním poli. Ukazatel zůstává platný i po zvětšení tabulky
+ * (přesouvají se celé prvky), dokud není prvek smazán. Při nedostatku
+ * paměti vrací NULL.
+ */
+float *ht_map_upsert(ht_map_t *map, char *key, float value) {
+    return ht_map_upsert_n(map, key, strlen(key), value);
+}
+
+/*
+ * Vložení nebo nalezení prvku s klíčem key délky length, viz
+ * ht_map_upsert. Klíč nemusí být ukončený nulou, nový prvek dostane kopii
+ * ukončenou nulou. Klíč delší než HT_ITEM_MAX_KEY se nevloží (vrací NULL).
+ */
+float *ht_map_upsert_n(ht_map_t *map, const char *key, size_t length,
+                       float value) {
+    if (length > HT_ITEM_MAX_KEY) {
+        return NULL;
+    }
+    return ht_map_upsert_hashed(map, key, length,
+                                ht_map_hash_n(map, key, length), value);
+}
+
+/*
+ * Vložení nového prvku do tabulky.
+ *
+ * Pokud prvek s daným klíčem už v tabulce existuje, nahradí se jeho hodnota.
+ */
+void ht_map_insert(ht_map_t *map, char *key, float value) {
+    ht_map_insert_n(map, key, strlen(key), value);
+}
+
+/*
+ * Vložení prvku s klíčem key délky length, viz ht_map_insert.
+ */
+void ht_map_insert_n(ht_map_t *map, const char *key, size_t length,
+                     float value) {
+    float *slot = ht_map_upsert_n(map, key, length, value);
+    if (slot != NULL) {
+        *slot = value;
+    }
+}
+
+/*
+ * Přičtení delta k hodnotě prvku jedním vyhledáním, chybějící prvek se
+ * vloží s hodnotou delta. Vrací ukazatel na novou hodnotu, při nedostatku
+ * paměti NULL.
+ */
+float *ht_map_add(ht_map_t *map, char *key, float delta) {
+    return ht_map_add_n(map, key, strlen(key), delta);
+}
+
+/*
+ * Přičtení delta k hodnotě prvku s klíčem key délky length, viz
+ * ht_map_add.
+ */
+float *ht_map_add_n(ht_map_t *map, const char *key, size_t length,
+                    float delta) {
+    float *slot = ht_map_upsert_n(map, key, length, 0.0);
+    if (slot != NULL) {
+        *slot += delta;
+    }
+    return slot;
+}
+
+/*
+ * Zvýšení hodnoty prvku o jedna, viz ht_map_add.
+ */
+float *ht_map_increment(ht_map_t *map, char *key) {
+    return ht_map_add(map, key, 1.0);
+}
+
+/*
+ * Zvýšení hodnoty prvku s klíčem key délky length o jedna, viz ht_map_add.
+ */
+float *ht_map_increment_n(ht_map_t *map, const char *key, size_t length) {
+    return ht_map_add_n(map, key, length, 1.0);
+}
+
+/*
+ * Získání hodnoty z tabulky.
+ *
+ * V případě úspěchu vrací funkce ukazatel na hodnotu prvku, v opačném
+ * případě hodnotu NULL.
+ */
+float *ht_map_get(ht_map_t *map, char *key) {
+    return ht_map_get_n(map, key, strlen(key));
+}
+
+/*
+ * Získání hodnoty prvku s klíčem key délky length, viz ht_map_get.
+ */
+float *ht_map_get_n(ht_map_t *map, const char *key, size_t length) {
+    ht_item_t *item = ht_map_search_n(map, key, length);
+    if (item == NULL) {
+        return NULL;
+    }
+    return &item->value;
+}
+
+/*
+ * Vyhledání skupiny nejvýše HT_ITEM_BATCH klíčů, viz ht_map_search_batch.
+ */
+static void ht_map_search_group(ht_map_t *map, char **keys, size_t count,
+                                ht_item_t **items) {
+    unsigned int hashes[HT_ITEM_BATCH];
+    size_t lengths[HT_ITEM_BATCH];
+    ht_item_t **slots[HT_ITEM_BATCH];
+    ht_item_t *cursor[HT_ITEM_BATCH];
+
+    // Hash every key and prefetch its bucket, then load and prefetch the
+    // chain heads, then walk the chains side by side
+    for (size_t i = 0; i < count; i++) {
+        hashes[i] = ht_map_hash(map, keys[i], &lengths[i]);
+        slots[i] =
+            &map->buckets[ht_map_index(hashes[i], map->size, map->shift)];
+        ht_item_prefetch(slots[i]);
+        items[i] = NULL;
+    }
+    for (size_t i = 0; i < count; i++) {
+        // Keys the filter rules out are not walked in either array
+        if (map->bloom != NULL && !ht_bloom_may_contain(map->bloom, hashes[i])) {
+            slots[i] = NULL;
+        }
+        cursor[i] = slots[i] != NULL ? *slots[i] : NULL;
+        if (cursor[i] != NULL) {
+            ht_item_prefetch(cursor[i]);
+        }
+    }
+    ht_item_walk_batch(cursor, keys, hashes, lengths, count, items);
+    if (map->old_buckets == NULL) {
+        return;
+    }
+
+    // Keys missing from the current array may still sit in a bucket of the
+    // old array that has not been migrated yet
+    for (size_t i = 0; i < count; i++) {
+        size_t old_index =
+            ht_map_index(hashes[i], map->old_size, map->old_shift);
+        cursor[i] = items[i] == NULL && slots[i] != NULL &&
+                            old_index >= map->migrate_pos
+                        ? map->old_buckets[old_index]
+                        : NULL;
+    }
+    ht_item_walk_batch(cursor, keys, hashes, lengths, count, items);
+}
+
+/*
+ * Vyhledání count klíčů najednou.
+ *
+ * Do items[i] zapíše prvek s klíčem keys[i], nebo NULL. Klíče se zpracují
+ * po skupinách HT_ITEM_BATCH: nejdřív se spočítají hashe a přednačtou
+ * řádky pole a začátky seznamů, pak se seznamy procházejí prokládaně, takže
+ * výpadky cache různých klíčů se překrývají místo toho, aby šly po sobě.
+ */
+void ht_map_search_batch(ht_map_t *map, char **keys, size_t count,
+                         ht_item_t **items) {
+    if (map->size == 0) {
+        for (size_t i = 0; i < count; i++) {
+            items[i] = NULL;
+        }
+        return;
+    }
+    for (size_t i = 0; i < count; i += HT_ITEM_BATCH) {
+        size_t group = count - i < HT_ITEM_BATCH ? count - i : HT_ITEM_BATCH;
+        ht_map_search_group(map, keys + i, group, items + i);
+    }
+}
+
+/*
+ * Získání hodnot count klíčů najednou.
+ *
+ * Do values[i] zapíše ukazatel na hodnotu prvku s klíčem keys[i], nebo NULL.
+ */
+void ht_map_get_batch(ht_map_t *map, char **keys, size_t count,
+                      float **values) {
+    ht_item_t *items[HT_ITEM_BATCH];
+    for (size_t i = 0; i < count; i += HT_ITEM_BATCH) {
+        size_t group = count - i < HT_ITEM_BATCH ? count - i : HT_ITEM_BATCH;
+        ht_map_search_batch(map, keys + i, group, items);
+        for (size_t j = 0; j < group; j++) {
+            values[i + j] = items[j] != NULL ? &items[j]->value : NULL;
+        }
+    }
+}
+
+/*
+ * Vyjmutí prvku ze seznamu synonym začínajícího v *head.
+ *
+ * Vrací vyjmutý prvek nebo NULL, pokud v seznamu není.
+ */
+static ht_item_t *ht_map_chain_unlink(ht_item_t **head, unsigned int hash,
+                                      const char *key, size_t length) {
+    ht_item_t *current = *head;
+    ht_item_t *previous = NULL;
+    while (current != NULL) {
+        if (ht_item_matches(current, hash, key, length)) {
+            if (previous == NULL) {
+                *head = current->next;
+            } else {
+                previous->next = current->next;
+            }
+            return current;
+        }
+        previous = current;
+        current = current->next;
+    }
+    return NULL;
+}
+
+/*
+ * Smazání prvku z tabulky.
+ *
+ * Funkce korektně uvolní všechny alokované zdroje přiřazené k danému prvku.
+ * Pokud prvek neexistuje, funkce nedělá nic.
+ */
+void ht_map_delete(ht_map_t *map, char *key) {
+    ht_map_delete_n(map, key, strlen(key));
+}
+
+/*
+ * Smazání prvku s klíčem key délky length, viz ht_map_delete.
+ */
+void ht_map_delete_n(ht_map_t *map, const char *key, size_t length) {
+    if (map->size == 0 || length > HT_ITEM_MAX_KEY) {
+        return;
+    }
+    ht_map_migrate_step(map, HT_MAP_REHASH_STEP);
+
+    unsigned int hash = ht_map_hash_n(map, key, length);
+    if (map->bloom != NULL && !ht_bloom_may_contain(map->bloom, hash)) {
+        return;
+    }
+    ht_item_t *deleted = ht_map_chain_unlink(
+        &map->buckets[ht_map_index(hash, map->size, map->shift)], hash, key,
+        length);
+    if (deleted == NULL && map->old_buckets != NULL) {
+        size_t old_index = ht_map_index(hash, map->old_size, map->old_shift);
+        if (old_index >= map->migrate_pos) {
+            deleted = ht_map_chain_unlink(&map->old_buckets[old_index], hash,
+                                          key, length);
+        }
+    }
+    if (deleted != NULL) {
+        ht_map_item_free(map, deleted);
+        map->count--;
+    }
+}
+
+/*
+ * Přesun prvků jednoho seznamu synonym ze src do dest (viz ht_map_merge).
+ * Vrací NULL, pokud se přesunuly všechny prvky, jinak prvek, jehož kopii
+ * se nepodařilo alokovat; ten a zbytek seznamu za ním v src zůstávají.
+ */
+static ht_item_t *ht_map_merge_chain(ht_map_t *dest, ht_map_t *src,
+                                     ht_item_t *item, ht_map_combine_t combine,
+                                     bool relink) {
+    while (item != NULL) {
+        ht_item_t *next = item->next;
+        unsigned int hash = dest->seed == src->seed
+                                ? item->hash
+                                : ht_map_hash_n(dest, item->key, item->key_len);
+        ht_item_t *existing = ht_map_find(dest, hash, item->key, item->key_len);
+        if (existing != NULL) {
+            existing->value = combine != NULL
+                                  ? combine(existing->value, item->value)
+                                  : item->value;
+        } else if (relink) {
+            ht_map_migrate_step(dest, HT_MAP_REHASH_STEP);
+            item->hash = hash;
+            ht_map_link(dest, item);
+            src->count--;
+            item = next;
+            continue;
+        } else if (ht_map_upsert_hashed(dest, item->key, item->key_len, hash,
+                                        item->value) == NULL) {
+            return item;
+        }
+        src->count--;
+        if (src->arena == NULL) {
+            ht_item_free(item);
+        }
+        item = next;
+    }
+    return NULL;
+}
+
+/*
+ * Sloučení tabulky src do tabulky dest.
+ *
+ * Prvky, jejichž klíč v dest chybí, se do dest přesunou — bez arén se jen
+ * přepojí, jinak se zkopírují. U klíče, který je v obou tabulkách, bude
+ * v dest hodnota combine(hodnota v dest, hodnota v src); pro combine == NULL
+ * se hodnota z src převezme. Tabulka src zůstane prázdná. Při stejném
+ * semínku se klíče znovu nehashují.
+ *
+ * Pokud se nepodaří alokovat kopii prvku, slučování skončí a vrací false;
+ * v src pak zůstanou právě prvky, které se do dest nepřesunuly.
+ */
+bool ht_map_merge(ht_map_t *dest, ht_map_t *src, ht_map_combine_t combine) {
+    bool relink = dest->arena == NULL && src->arena == NULL;
+    for (size_t i = 0; i < src->size; i++) {
+        ht_item_t *item = src->buckets[i];
+        src->buckets[i] = ht_map_merge_chain(dest, src, item, combine, relink);
+        if (src->buckets[i] != NULL) {
+            return false;
+        }
+    }
+    if (src->old_buckets != NULL) {
+        for (size_t i = src->migrate_pos; i < src->old_size; i++) {
+            ht_item_t *item = src->old_buckets[i];
+            src->old_buckets[i] =
+                ht_map_merge_chain(dest, src, item, combine, relink);
+            if (src->old_buckets[i] != NULL) {
+                return false;
+            }
+        }
+    }
+    // Only the emptied arrays and the arena are left to reset
+    ht_map_delete_all(src);
+    return true;
+}
+
+/*
+ * Uvolnění všech prvků v poli seznamů synonym. V arénovém režimu se pole jen
+ * vynuluje, paměť prvků uvolní ht_arena_reset.
+ */
+static void ht_map_free_buckets(ht_map_t *map, ht_item_t **buckets,
+                                size_t size) {
+    if (map->arena != NULL) {
+        memset(buckets, 0, size * sizeof(ht_item_t *));
+        return;
+    }
+    for (size_t i = 0; i < size; i++) {
+        ht_item_t *item = buckets[i];
+        while (item != NULL) {
+            ht_item_t *nextItem = item->next;
+            ht_item_free(item);
+            item = nextItem;
+        }
+        buckets[i] = NULL;
+    }
+}
+
+/*
+ * Smazání všech prvků z tabulky.
+ *
+ * Funkce uvolní všechny prvky i rozpracované staré pole. Aktuální pole si
+ * tabulka ponechá, takže opětovné plnění nemusí znovu procházet zvětšováním.
+ * V arénovém režimu stojí smazání jen vynulování pole a vyprázdnění arény.
+ */
+void ht_map_delete_all(ht_map_t *map) {
+    ht_map_free_buckets(map, map->buckets, map->size);
+    if (map->old_buckets != NULL) {
+        ht_map_free_buckets(map, map->old_buckets, map->old_size);
+        free(map->old_buckets);
+        map->old_buckets = NULL;
+        map->old_size = 0;
+        map->old_shift = 0;
+        map->migrate_pos = 0;
+    }
+    if (map->arena != NULL) {
+        ht_arena_reset(map->arena);
+    }
+    if (map->bloom != NULL) {
+        ht_bloom_clear(map->bloom);
+    }
+    map->count = 0;
+}
+
+/*
+ * Zrušení tabulky — uvolní všechny prvky, pole seznamů synonym i arénu.
+ */
+void ht_map_destroy(ht_map_t *map) {
+    ht_map_delete_all(map);
+    free(map->buckets);
+    map->buckets = NULL;
+    map->size = 0;
+    if (map->arena != NULL) {
+        ht_arena_destroy(map->arena);
+        free(map->arena);
+        map->arena = NULL;
+    }
+    ht_map_bloom_disable(map);
+}
@@ -0,0 +1,97 @@
+/*
+ * Hlavičkový soubor pro rostoucí tabulku s rozptýlenými položkami.
+ *
+ * Na rozdíl od ht_table_t nemá tabulka pevnou velikost MAX_HT_SIZE. Jakmile
+ * průměrná délka seznamu synonym překročí HT_MAP_MAX_LOAD, alokuje se zhruba
+ * dvojnásobné pole a položky se do něj přesouvají postupně — při každém
+ * ht_map_insert a ht_map_delete se přesune HT_MAP_REHASH_STEP řádků starého
+ * pole. Během přesouvání se vyhledává v obou polích.
+ *
+ * Pole má velikost prvočísla a index řádku je zbytek po dělení; tabulka
+ * z ht_map_init_pow2 má pole velikosti mocniny dvojky a index počítá
+ * násobením a posunem bez dělení.
+ *
+ * Volitelný Bloomův filtr (ht_map_bloom_enable) odpoví na většinu dotazů na
+ * chybějící klíč bez procházení seznamu synonym.
+ */
+
+#ifndef IAL_HT_MAP_H
+#define IAL_HT_MAP_H
+
+#include "hashtable.h"
+#include "ht_arena.h"
+#include "ht_bloom.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Počáteční velikost pole (musí být prvočíslo)
+#define HT_MAP_INIT_SIZE MAX_HT_SIZE
+
+// Počáteční velikost pole 2^HT_MAP_INIT_BITS pro ht_map_init_pow2
+#define HT_MAP_INIT_BITS 7
+
+// Maximální průměrný počet prvků na řádek před zvětšením tabulky
+#define HT_MAP_MAX_LOAD 1
+
+// Počet řádků starého pole přesunutých během jedné modifikující operace
+#define HT_MAP_REHASH_STEP 4
+
+// Rostoucí tabulka
+typedef struct ht_map {
+  ht_item_t **buckets;     // aktuální pole seznamů synonym
+  size_t size;             // velikost aktuálního pole (prvočíslo nebo 2^k)
+  unsigned int shift;      // 64 - k pro pole velikosti 2^k, jinak 0
+  ht_item_t **old_buckets; // pole, ze kterého se přesouvá, jinak NULL
+  size_t old_size;         // velikost starého pole
+  unsigned int old_shift;  // shift starého pole
+  size_t migrate_pos;      // první dosud nepřesunutý řádek starého pole
+  size_t count;            // počet prvků v tabulce
+  uint64_t seed;           // semínko rozptylovací funkce
+  ht_arena_t *arena;       // aréna pro prvky, NULL pro malloc/free
+  ht_bloom_t *bloom;       // filtr chybějících klíčů, NULL bez filtru
+} ht_map_t;
+
+// Sloučení hodnot stejného klíče při ht_map_merge
+typedef float (*ht_map_combine_t)(float current, float incoming);
+
+bool ht_map_init(ht_map_t *map);
+bool ht_map_init_seeded(ht_map_t *map, uint64_t seed);
+bool ht_map_init_arena(ht_map_t *map);
+bool ht_map_init_pow2(ht_map_t *map);
+bool ht_map_bloom_enable(ht_map_t *map, size_t expected);
+bool ht_map_bloom_rebuild(ht_map_t *map);
+void ht_map_bloom_disable(ht_map_t *map);
+ht_item_t *ht_map_search(ht_map_t *map, char *key);
+void ht_map_insert(ht_map_t *map, char *key, float value);
+float *ht_map_upsert(ht_map_t *map, char *key, float value);
+float *ht_map_add(ht_map_t *map, char *key, float delta);
+float *ht_map_increment(ht_map_t *map, char *key);
+float *ht_map_get(ht_map_t *map, char *key);
+void ht_map_search_batch(ht_map_t *map, char **keys, size_t count,
+                         ht_item_t **items);
+void ht_map_get_batch(ht_map_t *map, char **keys, size_t count,
+                      float **values);
+void ht_map_delete(ht_map_t *map, char *key);
+void ht_map_delete_all(ht_map_t *map);
+void ht_map_destroy(ht_map_t *map);
+bool ht_map_merge(ht_map_t *dest, ht_map_t *src, ht_map_combine_t combine);
+unsigned int ht_map_key_hash(ht_map_t *map, char *key, size_t *length);
+unsigned int ht_map_key_hash_n(ht_map_t *map, const char *key,
+                               size_t length);
+ht_item_t *ht_map_search_hashed(ht_map_t *map, const char *key,
+                                size_t length, unsigned int hash);
+float *ht_map_upsert_hashed(ht_map_t *map, const char *key, size_t length,
+                            unsigned int hash, float value);
+ht_item_t *ht_map_search_n(ht_map_t *map, const char *key, size_t length);
+void ht_map_insert_n(ht_map_t *map, const char *key, size_t length,
+                     float value);
+float *ht_map_upsert_n(ht_map_t *map, const char *key, size_t length,
+                       float value);
+float *ht_map_add_n(ht_map_t *map, const char *key, size_t length,
+                    float delta);
+float *ht_map_increment_n(ht_map_t *map, const char *key, size_t length);
+float *ht_map_get_n(ht_map_t *map, const char *key, size_t length);
+void ht_map_delete_n(ht_map_t *map, const char *key, size_t length);
+
+#endif
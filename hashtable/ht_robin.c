@@ -0,0 +1,284 @@
+/*
+ * Tabulka s otevřeným adresováním "Robin Hood"
+ *
+ * Domovský slot klíče určují dolní bity hashe, kolize se řeší lineárním
+ * průchodem. Prvky jsou v každém úseku obsazených slotů seřazené podle
+ * domovského slotu, takže vyhledávání může skončit dřív než na prázdném
+ * slotu.
+ */
+
+#include "ht_robin.h"
+#include "ht_hash.h"
+#include <stdlib.h>
+#include <string.h>
+
+static inline unsigned int ht_robin_hash(ht_robin_t *table, char *key) {
+    return ht_hash_fold(ht_hash_default(key, strlen(key), table->seed));
+}
+
+/*
+ * Zda by tabulka po vložení dalšího prvku překročila maximální zaplnění.
+ */
+static inline bool ht_robin_full(ht_robin_t *table) {
+    return (table->count + 1) * 100 > table->capacity * table->max_load;
+}
+
+/*
+ * Vyhledání klíče. Vrací true a index slotu, pokud klíč existuje; jinak
+ * vrací false a do *index a *dist zapíše místo, kam by klíč patřil.
+ */
+static bool ht_robin_find(ht_robin_t *table, unsigned int hash, char *key,
+                          size_t *index, uint32_t *dist) {
+    size_t mask = table->capacity - 1;
+    size_t i = hash & mask;
+    uint32_t d = 0;
+    for (;;) {
+        ht_robin_slot_t *slot = &table->slots[i];
+        // Stop at an empty slot or at an item closer to its home than we
+        // would be, the key would have displaced it on insertion
+        if (slot->key == NULL || slot->dist < d) {
+            *index = i;
+            *dist = d;
+            return false;
+        }
+        if (slot->hash == hash && strcmp(slot->key, key) == 0) {
+            *index = i;
+            *dist = d;
+            return true;
+        }
+        i = (i + 1) & mask;
+        d++;
+    }
+}
+
+/*
+ * Umístění prvku entry od slotu index se vzdáleností entry.dist. Bohatší
+ * prvky se odsouvají dál. Vrací index, kam se uložil právě vkládaný prvek.
+ */
+static size_t ht_robin_place(ht_robin_t *table, ht_robin_slot_t entry,
+                             size_t index) {
+    size_t mask = table->capacity - 1;
+    size_t placed = table->capacity;
+    for (;;) {
+        ht_robin_slot_t *slot = &table->slots[index];
+        if (slot->key == NULL) {
+            *slot = entry;
+            return placed == table->capacity ? index : placed;
+        }
+        if (slot->dist < entry.dist) {
+            // Take the slot from the richer item and carry that one on
+            ht_robin_slot_t displaced = *slot;
+            *slot = entry;
+            entry = displaced;
+            if (placed == table->capacity) {
+                placed = index;
+            }
+        }
+        index = (index + 1) & mask;
+        entry.dist++;
+    }
+}
+
+/*
+ * Alokace prázdného pole slotů dané kapacity.
+ */
+static ht_robin_slot_t *ht_robin_alloc(size_t capacity) {
+    return calloc(capacity, sizeof(ht_robin_slot_t));
+}
+
+/*
+ * Zdvojnásobení kapacity a rozmístění prvků podle uložených hashů.
+ */
+static bool ht_robin_grow(ht_robin_t *table) {
+    ht_robin_slot_t *old_slots = table->slots;
+    size_t old_capacity = table->capacity;
+    ht_robin_slot_t *slots = ht_robin_alloc(old_capacity * 2);
+    if (slots == NULL) {
+        return false;
+    }
+    table->slots = slots;
+    table->capacity = old_capacity * 2;
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_slots[i].key != NULL) {
+            ht_robin_slot_t entry = old_slots[i];
+            entry.dist = 0;
+            ht_robin_place(table, entry, entry.hash & (table->capacity - 1));
+        }
+    }
+    free(old_slots);
+    return true;
+}
+
+/*
+ * Inicializace tabulky s maximálním zaplněním max_load procent (10 až 99).
+ *
+ * Vrací false, pokud se nepodařilo alokovat pole.
+ */
+bool ht_robin_init_load(ht_robin_t *table, unsigned int max_load) {
+    if (max_load < 10) {
+        max_load = 10;
+    } else if (max_load > 99) {
+        max_load = 99;
+    }
+    table->max_load = max_load;
+    table->count = 0;
+    table->seed = 0;
+    table->slots = ht_robin_alloc(HT_ROBIN_INIT_CAPACITY);
+    table->capacity = table->slots != NULL ? HT_ROBIN_INIT_CAPACITY : 0;
+    return table->slots != NULL;
+}
+
+/*
+ * Inicializace tabulky — zavolá se před prvním použitím tabulky.
+ *
+ * Vrací false, pokud se nepodařilo alokovat pole.
+ */
+bool ht_robin_init(ht_robin_t *table) {
+    return ht_robin_init_load(table, HT_ROBIN_MAX_LOAD);
+}
+
+/*
+ * Vyhledání prvku v tabulce.
+ *
+ * V případě úspěchu vrací ukazatel na slot prvku; v opačném případě vrací
+ * hodnotu NULL. Ukazatel je platný do další modifikace tabulky.
+ */
+ht_robin_slot_t *ht_robin_search(ht_robin_t *table, char *key) {
+    size_t index;
+    uint32_t dist;
+    if (ht_robin_find(table, ht_robin_hash(table, key), key, &index, &dist)) {
+        return &table->slots[index];
+    }
+    return NULL;
+}
+
+/*
+ * Vložení nebo nalezení prvku.
+ *
+ * Pokud prvek s daným klíčem existuje, vrací ukazatel na jeho hodnotu beze
+ * změny, jinak vloží nový prvek s hodnotou value. Vkládání pokračuje od
+ * místa, kde skončilo vyhledání. Ukazatel je platný do další modifikace
+ * tabulky. Při nedostatku paměti vrací NULL.
+ */
+float *ht_robin_upsert(ht_robin_t *table, char *key, float value) {
+    unsigned int hash = ht_robin_hash(table, key);
+    size_t index;
+    uint32_t dist;
+    if (ht_robin_find(table, hash, key, &index, &dist)) {
+        return &table->slots[index].value;
+    }
+    if (ht_robin_full(table)) {
+        if (!ht_robin_grow(table)) {
+            return NULL;
+        }
+        ht_robin_find(table, hash, key, &index, &dist);
+    }
+
+    size_t length = strlen(key);
+    char *copy = malloc(length + 1);
+    if (copy == NULL) {
+        return NULL;
+    }
+    memcpy(copy, key, length + 1);
+
+    ht_robin_slot_t entry = {copy, value, hash, dist};
+    index = ht_robin_place(table, entry, index);
+    table->count++;
+    return &table->slots[index].value;
+}
+
+/*
+ * Vložení nového prvku do tabulky.
+ *
+ * Pokud prvek s daným klíčem už v tabulce existuje, nahradí se jeho hodnota.
+ */
+void ht_robin_insert(ht_robin_t *table, char *key, float value) {
+    float *slot = ht_robin_upsert(table, key, value);
+    if (slot != NULL) {
+        *slot = value;
+    }
+}
+
+/*
+ * Získání hodnoty z tabulky.
+ *
+ * V případě úspěchu vrací funkce ukazatel na hodnotu prvku, v opačném
+ * případě hodnotu NULL.
+ */
+float *ht_robin_get(ht_robin_t *table, char *key) {
+    ht_robin_slot_t *slot = ht_robin_search(table, key);
+    return slot != NULL ? &slot->value : NULL;
+}
+
+/*
+ * Smazání prvku z tabulky.
+ *
+ * Následující prvky, které nejsou ve svém domovském slotu, se posunou o jeden
+ * slot zpět, takže nevznikají smazané sloty a vzdálenosti zůstávají přesné.
+ */
+void ht_robin_delete(ht_robin_t *table, char *key) {
+    size_t index;
+    uint32_t dist;
+    if (!ht_robin_find(table, ht_robin_hash(table, key), key, &index, &dist)) {
+        return;
+    }
+    free(table->slots[index].key);
+
+    size_t mask = table->capacity - 1;
+    size_t next = (index + 1) & mask;
+    while (table->slots[next].key != NULL && table->slots[next].dist > 0) {
+        table->slots[index] = table->slots[next];
+        table->slots[index].dist--;
+        index = next;
+        next = (next + 1) & mask;
+    }
+    table->slots[index].key = NULL;
+    table->slots[index].dist = 0;
+    table->count--;
+}
+
+/*
+ * Smazání všech prvků z tabulky. Kapacita tabulky se zachová.
+ */
+void ht_robin_delete_all(ht_robin_t *table) {
+    for (size_t i = 0; i < table->capacity; i++) {
+        free(table->slots[i].key);
+        table->slots[i].key = NULL;
+        table->slots[i].dist = 0;
+    }
+    table->count = 0;
+}
+
+/*
+ * Zrušení tabulky — uvolní všechny prvky i pole slotů.
+ */
+void ht_robin_destroy(ht_robin_t *table) {
+    ht_robin_delete_all(table);
+    free(table->slots);
+    table->slots = NULL;
+    table->capacity = 0;
+}
+
+/*
+ * Výpočet statistiky vzdáleností prvků od jejich domovských slotů.
+ */
+void ht_robin_stats(ht_robin_t *table, ht_robin_stats_t *stats) {
+    double sum = 0, sum_sq = 0;
+    stats->max_dist = 0;
+    for (size_t i = 0; i < table->capacity; i++) {
+        if (table->slots[i].key != NULL) {
+            uint32_t d = table->slots[i].dist;
+            sum += d;
+            sum_sq += (double)d * d;
+            if (d > stats->max_dist) {
+                stats->max_dist = d;
+            }
+        }
+    }
+    double n = table->count > 0 ? (double)table->count : 1;
+    stats->mean_dist = sum / n;
+    stats->var_dist = sum_sq / n - stats->mean_dist * stats->mean_dist;
+    stats->load = table->capacity > 0
+                      ? (double)table->count / (double)table->capacity
+                      : 0;
+}
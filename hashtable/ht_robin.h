@@ -0,0 +1,61 @@
+/*
+ * Hlavičkový soubor pro tabulku s otevřeným adresováním "Robin Hood".
+ *
+ * Každý slot si pamatuje vzdálenost prvku od jeho domovského slotu. Při
+ * vkládání přenechá "bohatší" prvek (s menší vzdáleností) své místo
+ * "chudšímu", takže rozptyl délek posloupností zůstává malý i při zaplnění
+ * 0.9 a více. Neúspěšné vyhledání skončí, jakmile narazí na slot s menší
+ * vzdáleností, než by měl hledaný klíč. Mazání posouvá následující prvky
+ * zpět (backward shift), takže tabulka nepotřebuje smazané sloty.
+ */
+
+#ifndef IAL_HT_ROBIN_H
+#define IAL_HT_ROBIN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Počáteční kapacita (mocnina dvou)
+#define HT_ROBIN_INIT_CAPACITY 128
+
+// Výchozí maximální zaplnění v procentech
+#define HT_ROBIN_MAX_LOAD 90
+
+// Slot tabulky
+typedef struct ht_robin_slot {
+  char *key;         // kopie klíče, NULL pro prázdný slot
+  float value;       // hodnota prvku
+  unsigned int hash; // celý hash klíče
+  uint32_t dist;     // vzdálenost od domovského slotu
+} ht_robin_slot_t;
+
+// Tabulka
+typedef struct ht_robin {
+  ht_robin_slot_t *slots; // pole slotů
+  size_t capacity;        // počet slotů (mocnina dvou)
+  size_t count;           // počet prvků
+  unsigned int max_load;  // maximální zaplnění v procentech
+  uint64_t seed;          // semínko rozptylovací funkce
+} ht_robin_t;
+
+// Statistika délek posloupností
+typedef struct ht_robin_stats {
+  double mean_dist;   // průměrná vzdálenost prvku od domovského slotu
+  double var_dist;    // rozptyl vzdáleností
+  uint32_t max_dist;  // maximální vzdálenost
+  double load;        // aktuální zaplnění
+} ht_robin_stats_t;
+
+bool ht_robin_init(ht_robin_t *table);
+bool ht_robin_init_load(ht_robin_t *table, unsigned int max_load);
+ht_robin_slot_t *ht_robin_search(ht_robin_t *table, char *key);
+float *ht_robin_upsert(ht_robin_t *table, char *key, float value);
+void ht_robin_insert(ht_robin_t *table, char *key, float value);
+float *ht_robin_get(ht_robin_t *table, char *key);
+void ht_robin_delete(ht_robin_t *table, char *key);
+void ht_robin_delete_all(ht_robin_t *table);
+void ht_robin_destroy(ht_robin_t *table);
+void ht_robin_stats(ht_robin_t *table, ht_robin_stats_t *stats);
+
+#endif
@@ -0,0 +1,298 @@
+/*
+ * Dělená tabulka k souběžné agregaci
+ *
+ * Hash klíče se spočítá jednou; jeho horní bity vyberou část a celý hash
+ * se předá části přes ht_map_*_hashed. Dolní bity tak zůstávají pro výběr
+ * řádku v části.
+ */
+
+#include "ht_shard.h"
+#include "ht_item.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+static inline ht_map_t *ht_shard_part(ht_shard_t *shard, unsigned int hash) {
+    return &shard->parts[hash >> (32 - HT_SHARD_BITS)];
+}
+
+// Hash klíče délky length, všechny části mají stejné semínko
+static inline unsigned int ht_shard_hash(ht_shard_t *shard, const char *key,
+                                         size_t length) {
+    return ht_map_key_hash_n(&shard->parts[0], key, length);
+}
+
+/*
+ * Inicializace tabulky se zadaným semínkem rozptylovací funkce.
+ *
+ * Vrací false, pokud se nepodařilo alokovat pole.
+ */
+bool ht_shard_init_seeded(ht_shard_t *shard, uint64_t seed) {
+    for (int i = 0; i < HT_SHARD_PARTS; i++) {
+        if (!ht_map_init_seeded(&shard->parts[i], seed)) {
+            while (--i >= 0) {
+                ht_map_destroy(&shard->parts[i]);
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Inicializace tabulky — zavolá se před prvním použitím tabulky.
+ *
+ * Vrací false, pokud se nepodařilo alokovat pole.
+ */
+bool ht_shard_init(ht_shard_t *shard) {
+    return ht_shard_init_seeded(shard, 0);
+}
+
+/*
+ * Vyhledání prvku v tabulce.
+ *
+ * V případě úspěchu vrací ukazatel na nalezený prvek; v opačném případě
+ * vrací hodnotu NULL.
+ */
+ht_item_t *ht_shard_search(ht_shard_t *shard, char *key) {
+    return ht_shard_search_n(shard, key, strlen(key));
+}
+
+/*
+ * Vyhledání prvku s klíčem key délky length, který nemusí být ukončený
+ * nulou, viz ht_shard_search. Klíč delší než HT_ITEM_MAX_KEY v tabulce
+ * být nemůže a ani se nehashuje.
+ */
+ht_item_t *ht_shard_search_n(ht_shard_t *shard, const char *key,
+                             size_t length) {
+    if (length > HT_ITEM_MAX_KEY) {
+        return NULL;
+    }
+    unsigned int hash = ht_shard_hash(shard, key, length);
+    return ht_map_search_hashed(ht_shard_part(shard, hash), key, length, hash);
+}
+
+/*
+ * Vložení nebo nalezení prvku, viz ht_map_upsert.
+ */
+float *ht_shard_upsert(ht_shard_t *shard, char *key, float value) {
+    return ht_shard_upsert_n(shard, key, strlen(key), value);
+}
+
+/*
+ * Vložení nebo nalezení prvku s klíčem key délky length, viz
+ * ht_map_upsert_n. Klíč delší než HT_ITEM_MAX_KEY se nevloží (vrací NULL).
+ */
+float *ht_shard_upsert_n(ht_shard_t *shard, const char *key, size_t length,
+                         float value) {
+    if (length > HT_ITEM_MAX_KEY) {
+        return NULL;
+    }
+    unsigned int hash = ht_shard_hash(shard, key, length);
+    return ht_map_upsert_hashed(ht_shard_part(shard, hash), key, length, hash,
+                                value);
+}
+
+/*
+ * Přičtení delta k hodnotě prvku, viz ht_map_add.
+ */
+float *ht_shard_add(ht_shard_t *shard, char *key, float delta) {
+    return ht_shard_add_n(shard, key, strlen(key), delta);
+}
+
+/*
+ * Přičtení delta k hodnotě prvku s klíčem key délky length, viz
+ * ht_map_add_n.
+ */
+float *ht_shard_add_n(ht_shard_t *shard, const char *key, size_t length,
+                      float delta) {
+    float *slot = ht_shard_upsert_n(shard, key, length, 0.0);
+    if (slot != NULL) {
+        *slot += delta;
+    }
+    return slot;
+}
+
+/*
+ * Vložení nového prvku do tabulky.
+ *
+ * Pokud prvek s daným klíčem už v tabulce existuje, nahradí se jeho hodnota.
+ */
+void ht_shard_insert(ht_shard_t *shard, char *key, float value) {
+    ht_shard_insert_n(shard, key, strlen(key), value);
+}
+
+/*
+ * Vložení prvku s klíčem key délky length, viz ht_shard_insert.
+ */
+void ht_shard_insert_n(ht_shard_t *shard, const char *key, size_t length,
+                       float value) {
+    float *slot = ht_shard_upsert_n(shard, key, length, value);
+    if (slot != NULL) {
+        *slot = value;
+    }
+}
+
+/*
+ * Získání hodnoty z tabulky.
+ *
+ * V případě úspěchu vrací funkce ukazatel na hodnotu prvku, v opačném
+ * případě hodnotu NULL.
+ */
+float *ht_shard_get(ht_shard_t *shard, char *key) {
+    return ht_shard_get_n(shard, key, strlen(key));
+}
+
+/*
+ * Získání hodnoty prvku s klíčem key délky length, viz ht_shard_get.
+ */
+float *ht_shard_get_n(ht_shard_t *shard, const char *key, size_t length) {
+    ht_item_t *item = ht_shard_search_n(shard, key, length);
+    return item != NULL ? &item->value : NULL;
+}
+
+/*
+ * Smazání prvku z tabulky.
+ */
+void ht_shard_delete(ht_shard_t *shard, char *key) {
+    ht_shard_delete_n(shard, key, strlen(key));
+}
+
+/*
+ * Smazání prvku s klíčem key délky length, viz ht_shard_delete.
+ */
+void ht_shard_delete_n(ht_shard_t *shard, const char *key, size_t length) {
+    if (length > HT_ITEM_MAX_KEY) {
+        return;
+    }
+    unsigned int hash = ht_shard_hash(shard, key, length);
+    ht_map_delete_n(ht_shard_part(shard, hash), key, length);
+}
+
+/*
+ * Smazání všech prvků z tabulky.
+ */
+void ht_shard_delete_all(ht_shard_t *shard) {
+    for (int i = 0; i < HT_SHARD_PARTS; i++) {
+        ht_map_delete_all(&shard->parts[i]);
+    }
+}
+
+/*
+ * Zrušení tabulky — uvolní všechny části.
+ */
+void ht_shard_destroy(ht_shard_t *shard) {
+    for (int i = 0; i < HT_SHARD_PARTS; i++) {
+        ht_map_destroy(&shard->parts[i]);
+    }
+}
+
+/*
+ * Počet prvků ve všech částech tabulky.
+ */
+size_t ht_shard_count(ht_shard_t *shard) {
+    size_t count = 0;
+    for (int i = 0; i < HT_SHARD_PARTS; i++) {
+        count += shard->parts[i].count;
+    }
+    return count;
+}
+
+// Zadání pro jedno vlákno slučování
+typedef struct ht_shard_job {
+  ht_shard_t *dest;         // cílová tabulka
+  ht_shard_t *shards;       // slučované tabulky
+  size_t count;             // počet slučovaných tabulek
+  ht_map_combine_t combine; // sloučení hodnot stejného klíče
+  unsigned int first;       // první část zpracovaná vláknem
+  unsigned int step;        // krok mezi částmi (počet vláken)
+  bool failed;              // některou část se nepodařilo sloučit
+} ht_shard_job_t;
+
+/*
+ * Sloučení částí first, first + step, ... ze všech tabulek do cílové.
+ * Tabulky se slučují v pořadí, v jakém jsou v poli. Při nedostatku paměti
+ * nastaví failed a ze zbylých tabulek už tutéž část neslučuje, aby se
+ * pořadí slučování hodnot nezměnilo.
+ */
+static void *ht_shard_merge_parts(void *arg) {
+    ht_shard_job_t *job = arg;
+    for (unsigned int p = job->first; p < HT_SHARD_PARTS; p += job->step) {
+        for (size_t s = 0; s < job->count; s++) {
+            if (&job->shards[s] != job->dest &&
+                !ht_map_merge(&job->dest->parts[p], &job->shards[s].parts[p],
+                              job->combine)) {
+                job->failed = true;
+                break;
+            }
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Sloučení count tabulek z pole shards do tabulky dest pomocí threads
+ * vláken (nejvýše HT_SHARD_PARTS užitečných).
+ *
+ * Hodnoty stejného klíče se slučují funkcí combine v pořadí tabulek v poli,
+ * například ht_shard_sum nebo ht_shard_replace (vyhraje poslední tabulka).
+ * Cílová tabulka může být jednou z tabulek v poli; ostatní zůstanou
+ * prázdné. Části, pro které se nepodaří spustit vlákno, sloučí volající
+ * vlákno.
+ *
+ * Při nedostatku paměti vrací false; prvky, které se nesloučily, zůstanou
+ * ve svých tabulkách.
+ */
+bool ht_shard_merge(ht_shard_t *dest, ht_shard_t *shards, size_t count,
+                    ht_map_combine_t combine, unsigned int threads) {
+    if (threads > HT_SHARD_PARTS) {
+        threads = HT_SHARD_PARTS;
+    }
+    if (threads <= 1) {
+        ht_shard_job_t job = {dest, shards, count, combine, 0, 1, false};
+        ht_shard_merge_parts(&job);
+        return !job.failed;
+    }
+
+    ht_shard_job_t jobs[HT_SHARD_PARTS];
+    pthread_t workers[HT_SHARD_PARTS];
+    unsigned int started = 0;
+    for (unsigned int t = 0; t < threads; t++) {
+        jobs[t] =
+            (ht_shard_job_t){dest, shards, count, combine, t, threads, false};
+    }
+    for (unsigned int t = 0; t < threads; t++) {
+        if (pthread_create(&workers[t], NULL, ht_shard_merge_parts, &jobs[t]) !=
+            0) {
+            break;
+        }
+        started++;
+    }
+    for (unsigned int t = 0; t < started; t++) {
+        pthread_join(workers[t], NULL);
+    }
+    // Merge the parts of jobs whose thread did not start here
+    for (unsigned int t = started; t < threads; t++) {
+        ht_shard_merge_parts(&jobs[t]);
+    }
+    bool merged = true;
+    for (unsigned int t = 0; t < threads; t++) {
+        merged = merged && !jobs[t].failed;
+    }
+    return merged;
+}
+
+/*
+ * Sloučení hodnot sečtením, například pro počty výskytů.
+ */
+float ht_shard_sum(float current, float incoming) {
+    return current + incoming;
+}
+
+/*
+ * Sloučení hodnot převzetím nové hodnoty.
+ */
+float ht_shard_replace(float current, float incoming) {
+    (void)current;
+    return incoming;
+}
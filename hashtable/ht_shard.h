@@ -0,0 +1,58 @@
+/*
+ * Hlavičkový soubor pro dělenou tabulku k souběžné agregaci.
+ *
+ * Každé pracovní vlákno plní vlastní ht_shard_t bez jakékoliv synchronizace.
+ * Tabulka je vnitřně rozdělená na HT_SHARD_PARTS částí (ht_map_t) podle
+ * horních bitů hashe. Funkce ht_shard_merge pak sloučí všechny tabulky do
+ * jedné tak, že každé vlákno slučování zpracuje jiné části — stejná část
+ * všech tabulek obsahuje stejnou podmnožinu klíčů, takže vlákna nesdílí nic.
+ * Všechny slučované tabulky musí mít stejné semínko.
+ */
+
+#ifndef IAL_HT_SHARD_H
+#define IAL_HT_SHARD_H
+
+#include "ht_map.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Počet bitů hashe určujících část tabulky
+#define HT_SHARD_BITS 4
+
+// Počet částí tabulky, zároveň nejvyšší užitečný počet vláken slučování
+#define HT_SHARD_PARTS (1 << HT_SHARD_BITS)
+
+// Tabulka jednoho vlákna
+typedef struct ht_shard {
+  ht_map_t parts[HT_SHARD_PARTS]; // části podle horních bitů hashe
+} ht_shard_t;
+
+bool ht_shard_init(ht_shard_t *shard);
+bool ht_shard_init_seeded(ht_shard_t *shard, uint64_t seed);
+ht_item_t *ht_shard_search(ht_shard_t *shard, char *key);
+float *ht_shard_upsert(ht_shard_t *shard, char *key, float value);
+float *ht_shard_add(ht_shard_t *shard, char *key, float delta);
+void ht_shard_insert(ht_shard_t *shard, char *key, float value);
+float *ht_shard_get(ht_shard_t *shard, char *key);
+void ht_shard_delete(ht_shard_t *shard, char *key);
+void ht_shard_delete_all(ht_shard_t *shard);
+ht_item_t *ht_shard_search_n(ht_shard_t *shard, const char *key,
+                             size_t length);
+float *ht_shard_upsert_n(ht_shard_t *shard, const char *key, size_t length,
+                         float value);
+float *ht_shard_add_n(ht_shard_t *shard, const char *key, size_t length,
+                      float delta);
+void ht_shard_insert_n(ht_shard_t *shard, const char *key, size_t length,
+                       float value);
+float *ht_shard_get_n(ht_shard_t *shard, const char *key, size_t length);
+void ht_shard_delete_n(ht_shard_t *shard, const char *key, size_t length);
+void ht_shard_destroy(ht_shard_t *shard);
+size_t ht_shard_count(ht_shard_t *shard);
+bool ht_shard_merge(ht_shard_t *dest, ht_shard_t *shards, size_t count,
+                    ht_map_combine_t combine, unsigned int threads);
+
+float ht_shard_sum(float current, float incoming);
+float ht_shard_replace(float current, float incoming);
+
+#endif
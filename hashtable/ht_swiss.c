@@ -0,0 +1,332 @@
+/*
+ * Tabulka s otevřeným adresováním typu "Swiss table"
+ *
+ * Hash klíče se dělí na dvě části: dolní bity určují první skupinu slotů
+ * (H1), horních sedm bitů se ukládá do řídicího bajtu slotu (H2). Vyhledání
+ * porovná H2 se všemi řídicími bajty skupiny najednou a klíče porovná jen
+ * u shodných slotů. Skupiny se procházejí kvadratickým (trojúhelníkovým)
+ * krokem, který při počtu skupin rovném mocnině dvou navštíví všechny.
+ */
+
+#include "ht_swiss.h"
+#include "ht_hash.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Řídicí bajty volných slotů (obsazené sloty mají hodnotu H2 0..127)
+#define HT_CTRL_EMPTY ((int8_t)-128)
+#define HT_CTRL_DELETED ((int8_t)-2)
+
+// Maximální zaplnění 7/8 kapacity
+#define HT_SWISS_MAX_LOAD(capacity) ((capacity) - (capacity) / 8)
+
+// Bitová maska slotů jedné skupiny
+typedef unsigned int ht_swiss_mask_t;
+
+static inline unsigned int ht_swiss_hash(ht_swiss_t *table, char *key) {
+    return ht_hash_fold(ht_hash_default(key, strlen(key), table->seed));
+}
+
+static inline int8_t ht_swiss_h2(unsigned int hash) {
+    return (int8_t)(hash >> 25);
+}
+
+/*
+ * Index nejnižšího nastaveného bitu nenulové masky.
+ */
+static inline unsigned int ht_swiss_lowest(ht_swiss_mask_t mask) {
+#if defined(__GNUC__)
+    return (unsigned int)__builtin_ctz(mask);
+#else
+    unsigned int i = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+#ifdef __SSE2__
+
+/*
+ * Maska slotů skupiny, jejichž řídicí bajt je roven value.
+ */
+static inline ht_swiss_mask_t ht_swiss_match(const int8_t *group,
+                                             int8_t value) {
+    __m128i ctrl = _mm_load_si128((const __m128i *)group);
+    return (ht_swiss_mask_t)_mm_movemask_epi8(
+        _mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value)));
+}
+
+/*
+ * Maska volných (prázdných nebo smazaných) slotů skupiny — obsazené sloty
+ * mají nejvyšší bit řídicího bajtu nulový.
+ */
+static inline ht_swiss_mask_t ht_swiss_match_free(const int8_t *group) {
+    __m128i ctrl = _mm_load_si128((const __m128i *)group);
+    return (ht_swiss_mask_t)_mm_movemask_epi8(ctrl);
+}
+
+#else
+
+static inline ht_swiss_mask_t ht_swiss_match(const int8_t *group,
+                                             int8_t value) {
+    ht_swiss_mask_t mask = 0;
+    for (unsigned int i = 0; i < HT_SWISS_GROUP; i++) {
+        mask |= (ht_swiss_mask_t)(group[i] == value) << i;
+    }
+    return mask;
+}
+
+static inline ht_swiss_mask_t ht_swiss_match_free(const int8_t *group) {
+    ht_swiss_mask_t mask = 0;
+    for (unsigned int i = 0; i < HT_SWISS_GROUP; i++) {
+        mask |= (ht_swiss_mask_t)(group[i] < 0) << i;
+    }
+    return mask;
+}
+
+#endif
+
+/*
+ * Vyhledání slotu s daným klíčem. Vrací index slotu nebo capacity, pokud
+ * klíč v tabulce není.
+ */
+static size_t ht_swiss_find(ht_swiss_t *table, unsigned int hash, char *key) {
+    size_t group_mask = table->capacity / HT_SWISS_GROUP - 1;
+    size_t group = hash & group_mask;
+    int8_t h2 = ht_swiss_h2(hash);
+
+    for (size_t step = 0; step <= group_mask; step++) {
+        const int8_t *ctrl = table->ctrl + group * HT_SWISS_GROUP;
+        ht_swiss_mask_t mask = ht_swiss_match(ctrl, h2);
+        while (mask != 0) {
+            size_t index = group * HT_SWISS_GROUP + ht_swiss_lowest(mask);
+            ht_swiss_slot_t *slot = &table->slots[index];
+            if (slot->hash == hash && strcmp(slot->key, key) == 0) {
+                return index;
+            }
+            mask &= mask - 1;
+        }
+        // An empty slot ends every probe sequence that reached this group
+        if (ht_swiss_match(ctrl, HT_CTRL_EMPTY) != 0) {
+            break;
+        }
+        group = (group + step + 1) & group_mask;
+    }
+    return table->capacity;
+}
+
+/*
+ * První volný (prázdný nebo smazaný) slot v posloupnosti skupin pro hash.
+ * Tabulka vždy nějaký volný slot má.
+ */
+static size_t ht_swiss_find_free(ht_swiss_t *table, unsigned int hash) {
+    size_t group_mask = table->capacity / HT_SWISS_GROUP - 1;
+    size_t group = hash & group_mask;
+    for (size_t step = 0;; step++) {
+        ht_swiss_mask_t mask =
+            ht_swiss_match_free(table->ctrl + group * HT_SWISS_GROUP);
+        if (mask != 0) {
+            return group * HT_SWISS_GROUP + ht_swiss_lowest(mask);
+        }
+        group = (group + step + 1) & group_mask;
+    }
+}
+
+/*
+ * Alokace prázdných polí pro danou kapacitu.
+ */
+static bool ht_swiss_alloc(ht_swiss_t *table, size_t capacity) {
+    int8_t *ctrl = aligned_alloc(HT_SWISS_GROUP, capacity);
+    ht_swiss_slot_t *slots = malloc(capacity * sizeof(ht_swiss_slot_t));
+    if (ctrl == NULL || slots == NULL) {
+        free(ctrl);
+        free(slots);
+        return false;
+    }
+    memset(ctrl, HT_CTRL_EMPTY, capacity);
+    table->ctrl = ctrl;
+    table->slots = slots;
+    table->capacity = capacity;
+    table->growth_left = HT_SWISS_MAX_LOAD(capacity) - table->count;
+    return true;
+}
+
+/*
+ * Přestavění tabulky s novou kapacitou — zahodí smazané sloty a prvky
+ * rozmístí podle uložených hashů. Při nedostatku paměti vrací false
+ * a tabulka zůstává beze změny.
+ */
+static bool ht_swiss_resize(ht_swiss_t *table, size_t capacity) {
+    int8_t *old_ctrl = table->ctrl;
+    ht_swiss_slot_t *old_slots = table->slots;
+    size_t old_capacity = table->capacity;
+    size_t old_growth_left = table->growth_left;
+
+    if (!ht_swiss_alloc(table, capacity)) {
+        table->ctrl = old_ctrl;
+        table->slots = old_slots;
+        table->capacity = old_capacity;
+        table->growth_left = old_growth_left;
+        return false;
+    }
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_ctrl[i] >= 0) {
+            size_t index = ht_swiss_find_free(table, old_slots[i].hash);
+            table->ctrl[index] = old_ctrl[i];
+            table->slots[index] = old_slots[i];
+        }
+    }
+    free(old_ctrl);
+    free(old_slots);
+    return true;
+}
+
+/*
+ * Inicializace tabulky — zavolá se před prvním použitím tabulky.
+ *
+ * Vrací false, pokud se nepodařilo alokovat pole.
+ */
+bool ht_swiss_init(ht_swiss_t *table) {
+    table->count = 0;
+    table->seed = 0;
+    table->capacity = 0;
+    return ht_swiss_alloc(table, HT_SWISS_INIT_CAPACITY);
+}
+
+/*
+ * Vyhledání prvku v tabulce.
+ *
+ * V případě úspěchu vrací ukazatel na slot prvku; v opačném případě vrací
+ * hodnotu NULL. Ukazatel je platný do další modifikace tabulky.
+ */
+ht_swiss_slot_t *ht_swiss_search(ht_swiss_t *table, char *key) {
+    size_t index = ht_swiss_find(table, ht_swiss_hash(table, key), key);
+    return index < table->capacity ? &table->slots[index] : NULL;
+}
+
+/*
+ * Vložení nebo nalezení prvku jedním průchodem.
+ *
+ * Pokud prvek s daným klíčem existuje, vrací ukazatel na jeho hodnotu beze
+ * změny, jinak vloží nový prvek s hodnotou value. Ukazatel je platný do
+ * další modifikace tabulky. Při nedostatku paměti vrací NULL.
+ */
+float *ht_swiss_upsert(ht_swiss_t *table, char *key, float value) {
+    unsigned int hash = ht_swiss_hash(table, key);
+    size_t index = ht_swiss_find(table, hash, key);
+    if (index < table->capacity) {
+        return &table->slots[index].value;
+    }
+
+    index = ht_swiss_find_free(table, hash);
+    if (table->growth_left == 0 && table->ctrl[index] == HT_CTRL_EMPTY) {
+        // Grow when mostly full, otherwise just purge the tombstones
+        size_t capacity = table->capacity;
+        if (table->count >= HT_SWISS_MAX_LOAD(capacity) / 2) {
+            capacity *= 2;
+        }
+        if (!ht_swiss_resize(table, capacity)) {
+            return NULL;
+        }
+        index = ht_swiss_find_free(table, hash);
+    }
+
+    size_t length = strlen(key);
+    char *copy = malloc(length + 1);
+    if (copy == NULL) {
+        return NULL;
+    }
+    memcpy(copy, key, length + 1);
+
+    if (table->ctrl[index] == HT_CTRL_EMPTY) {
+        table->growth_left--;
+    }
+    table->ctrl[index] = ht_swiss_h2(hash);
+    table->slots[index].key = copy;
+    table->slots[index].value = value;
+    table->slots[index].hash = hash;
+    table->count++;
+    return &table->slots[index].value;
+}
+
+/*
+ * Vložení nového prvku do tabulky.
+ *
+ * Pokud prvek s daným klíčem už v tabulce existuje, nahradí se jeho hodnota.
+ */
+void ht_swiss_insert(ht_swiss_t *table, char *key, float value) {
+    float *slot = ht_swiss_upsert(table, key, value);
+    if (slot != NULL) {
+        *slot = value;
+    }
+}
+
+/*
+ * Získání hodnoty z tabulky.
+ *
+ * V případě úspěchu vrací funkce ukazatel na hodnotu prvku, v opačném
+ * případě hodnotu NULL.
+ */
+float *ht_swiss_get(ht_swiss_t *table, char *key) {
+    ht_swiss_slot_t *slot = ht_swiss_search(table, key);
+    return slot != NULL ? &slot->value : NULL;
+}
+
+/*
+ * Smazání prvku z tabulky.
+ *
+ * Pokud skupina slotu obsahuje prázdný slot, žádné vyhledávání přes ni
+ * nepokračovalo a slot se může označit za prázdný. Jinak se označí za
+ * smazaný, aby se nepřerušily posloupnosti jiných klíčů.
+ */
+void ht_swiss_delete(ht_swiss_t *table, char *key) {
+    size_t index = ht_swiss_find(table, ht_swiss_hash(table, key), key);
+    if (index == table->capacity) {
+        return;
+    }
+    free(table->slots[index].key);
+
+    const int8_t *group =
+        table->ctrl + index / HT_SWISS_GROUP * HT_SWISS_GROUP;
+    if (ht_swiss_match(group, HT_CTRL_EMPTY) != 0) {
+        table->ctrl[index] = HT_CTRL_EMPTY;
+        table->growth_left++;
+    } else {
+        table->ctrl[index] = HT_CTRL_DELETED;
+    }
+    table->count--;
+}
+
+/*
+ * Smazání všech prvků z tabulky. Kapacita tabulky se zachová.
+ */
+void ht_swiss_delete_all(ht_swiss_t *table) {
+    for (size_t i = 0; i < table->capacity; i++) {
+        if (table->ctrl[i] >= 0) {
+            free(table->slots[i].key);
+        }
+    }
+    memset(table->ctrl, HT_CTRL_EMPTY, table->capacity);
+    table->count = 0;
+    table->growth_left = HT_SWISS_MAX_LOAD(table->capacity);
+}
+
+/*
+ * Zrušení tabulky — uvolní všechny prvky i pole.
+ */
+void ht_swiss_destroy(ht_swiss_t *table) {
+    ht_swiss_delete_all(table);
+    free(table->ctrl);
+    free(table->slots);
+    table->ctrl = NULL;
+    table->slots = NULL;
+    table->capacity = 0;
+    table->growth_left = 0;
+}
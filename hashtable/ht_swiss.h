@@ -0,0 +1,50 @@
+/*
+ * Hlavičkový soubor pro tabulku s otevřeným adresováním typu "Swiss table".
+ *
+ * Prvky leží v jednom poli slotů bez ukazatelů na synonyma. Ke každému slotu
+ * patří jeden řídicí bajt: prázdný, smazaný, nebo obsazený se sedmi bity
+ * hashe. Řídicí bajty se prohledávají po skupinách HT_SWISS_GROUP najednou
+ * (s SSE2 jedinou instrukcí porovnání), takže vyhledání obvykle čte jednu
+ * skupinu řídicích bajtů a jediný slot.
+ */
+
+#ifndef IAL_HT_SWISS_H
+#define IAL_HT_SWISS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Počet řídicích bajtů zpracovaných najednou
+#define HT_SWISS_GROUP 16
+
+// Počáteční kapacita (mocnina dvou, násobek HT_SWISS_GROUP)
+#define HT_SWISS_INIT_CAPACITY 128
+
+// Slot tabulky
+typedef struct ht_swiss_slot {
+  char *key;         // kopie klíče
+  float value;       // hodnota prvku
+  unsigned int hash; // celý hash klíče
+} ht_swiss_slot_t;
+
+// Tabulka
+typedef struct ht_swiss {
+  int8_t *ctrl;            // řídicí bajty, zarovnané na HT_SWISS_GROUP
+  ht_swiss_slot_t *slots;  // pole slotů
+  size_t capacity;         // počet slotů (mocnina dvou)
+  size_t count;            // počet prvků
+  size_t growth_left;      // počet prázdných slotů, které lze ještě obsadit
+  uint64_t seed;           // semínko rozptylovací funkce
+} ht_swiss_t;
+
+bool ht_swiss_init(ht_swiss_t *table);
+ht_swiss_slot_t *ht_swiss_search(ht_swiss_t *table, char *key);
+float *ht_swiss_upsert(ht_swiss_t *table, char *key, float value);
+void ht_swiss_insert(ht_swiss_t *table, char *key, float value);
+float *ht_swiss_get(ht_swiss_t *table, char *key);
+void ht_swiss_delete(ht_swiss_t *table, char *key);
+void ht_swiss_delete_all(ht_swiss_t *table);
+void ht_swiss_destroy(ht_swiss_t *table);
+
+#endif
@@ -0,0 +1,340 @@
+/*
+ * Zřetězená tabulka s rozvinutými seznamy synonym
+ *
+ * Řádek klíče určují dolní bity hashe, značku horních 16 bitů součinu
+ * hashe se zlatým řezem 2^64, takže značka nezávisí jen na bitech indexu.
+ * Cizí klíč se stejnou značkou projde až na strcmp zhruba jednou z 65536
+ * porovnání. Nový prvek se přidá do posledního uzlu seznamu; smazaný
+ * prvek nahradí poslední prvek seznamu. Hash se v uzlu neukládá, při
+ * zvětšení tabulky se klíče hashují znovu.
+ */
+
+#include "ht_unrolled.h"
+#include "ht_hash.h"
+#include <stdlib.h>
+#include <string.h>
+
+_Static_assert(sizeof(ht_unrolled_node_t) == 64,
+               "ht_unrolled_node_t má zabírat jeden řádek cache");
+
+static inline uint64_t ht_unrolled_hash(ht_unrolled_t *table, char *key) {
+    return ht_hash_default(key, strlen(key), table->seed);
+}
+
+static inline uint16_t ht_unrolled_tag(uint64_t hash) {
+    return (uint16_t)((hash * 0x9E3779B97F4A7C15ull) >> 48);
+}
+
+static inline ht_unrolled_node_t *ht_unrolled_bucket(ht_unrolled_t *table,
+                                                     uint64_t hash) {
+    return &table->buckets[ht_hash_fold(hash) & (table->bucket_count - 1)];
+}
+
+/*
+ * Počet obsazených slotů uzlu (obsazené sloty jsou na začátku).
+ */
+static inline unsigned int ht_unrolled_used(const ht_unrolled_node_t *node) {
+    unsigned int used = 0;
+    while (used < HT_UNROLLED_SLOTS && node->keys[used] != NULL) {
+        used++;
+    }
+    return used;
+}
+
+/*
+ * Vyhledání klíče v seznamu začínajícím uzlem node. Vrací uzel s klíčem
+ * a do *slot uloží jeho pozici v uzlu. Pokud klíč v seznamu není, vrací
+ * NULL a do *last uloží poslední uzel seznamu (tam se vloží nový prvek).
+ */
+static ht_unrolled_node_t *ht_unrolled_find(ht_unrolled_node_t *node,
+                                            uint16_t tag, char *key,
+                                            unsigned int *slot,
+                                            ht_unrolled_node_t **last) {
+    for (;; node = node->next) {
+        for (unsigned int i = 0; i < HT_UNROLLED_SLOTS; i++) {
+            if (node->keys[i] == NULL) {
+                break;
+            }
+            if (node->tags[i] == tag && strcmp(node->keys[i], key) == 0) {
+                *slot = i;
+                return node;
+            }
+        }
+        if (node->next == NULL) {
+            *last = node;
+            return NULL;
+        }
+    }
+}
+
+/*
+ * Přidání prvku za konec seznamu s posledním uzlem last; při plném uzlu se
+ * alokuje nový. Vrací ukazatel na hodnotu nového prvku, nebo NULL při
+ * nedostatku paměti.
+ */
+static float *ht_unrolled_append(ht_unrolled_t *table, ht_unrolled_node_t *last,
+                                 char *key, float value, uint16_t tag) {
+    unsigned int used = ht_unrolled_used(last);
+    if (used == HT_UNROLLED_SLOTS) {
+        ht_unrolled_node_t *node = aligned_alloc(sizeof(ht_unrolled_node_t),
+                                                 sizeof(ht_unrolled_node_t));
+        if (node == NULL) {
+            return NULL;
+        }
+        memset(node, 0, sizeof(ht_unrolled_node_t));
+        last->next = node;
+        last = node;
+        used = 0;
+        table->node_count++;
+    }
+    last->keys[used] = key;
+    last->values[used] = value;
+    last->tags[used] = tag;
+    return &last->values[used];
+}
+
+/*
+ * Uvolnění přetékajících uzlů všech seznamů v poli buckets, klíče zůstávají.
+ */
+static void ht_unrolled_free_nodes(ht_unrolled_node_t *buckets,
+                                   size_t bucket_count) {
+    for (size_t b = 0; b < bucket_count; b++) {
+        ht_unrolled_node_t *node = buckets[b].next;
+        while (node != NULL) {
+            ht_unrolled_node_t *next = node->next;
+            free(node);
+            node = next;
+        }
+    }
+}
+
+/*
+ * Alokace pole bucket_count prázdných prvních uzlů.
+ */
+static ht_unrolled_node_t *ht_unrolled_alloc_buckets(size_t bucket_count) {
+    ht_unrolled_node_t *buckets =
+        aligned_alloc(sizeof(ht_unrolled_node_t),
+                      bucket_count * sizeof(ht_unrolled_node_t));
+    if (buckets != NULL) {
+        memset(buckets, 0, bucket_count * sizeof(ht_unrolled_node_t));
+    }
+    return buckets;
+}
+
+/*
+ * Přestavění tabulky s bucket_count řádky. Klíče se znovu zahashují, jejich
+ * kopie se znovu nealokují. Při nedostatku paměti vrací false a tabulka
+ * zůstává beze změny.
+ */
+static bool ht_unrolled_rehash(ht_unrolled_t *table, size_t bucket_count) {
+    ht_unrolled_t grown = *table;
+    grown.bucket_count = bucket_count;
+    grown.node_count = 0;
+    grown.buckets = ht_unrolled_alloc_buckets(bucket_count);
+    if (grown.buckets == NULL) {
+        return false;
+    }
+
+    for (size_t b = 0; b < table->bucket_count; b++) {
+        for (ht_unrolled_node_t *node = &table->buckets[b]; node != NULL;
+             node = node->next) {
+            for (unsigned int i = 0; i < ht_unrolled_used(node); i++) {
+                uint64_t hash = ht_unrolled_hash(table, node->keys[i]);
+                ht_unrolled_node_t *last = ht_unrolled_bucket(&grown, hash);
+                while (last->next != NULL) {
+                    last = last->next;
+                }
+                float *moved = ht_unrolled_append(&grown, last, node->keys[i],
+                                                  node->values[i],
+                                                  node->tags[i]);
+                if (moved == NULL) {
+                    ht_unrolled_free_nodes(grown.buckets, bucket_count);
+                    free(grown.buckets);
+                    return false;
+                }
+            }
+        }
+    }
+    ht_unrolled_free_nodes(table->buckets, table->bucket_count);
+    free(table->buckets);
+    *table = grown;
+    return true;
+}
+
+/*
+ * Inicializace tabulky — zavolá se před prvním použitím tabulky.
+ *
+ * Vrací false, pokud se nepodařilo alokovat pole.
+ */
+bool ht_unrolled_init(ht_unrolled_t *table) {
+    table->count = 0;
+    table->node_count = 0;
+    table->seed = 0;
+    table->bucket_count = HT_UNROLLED_INIT_BUCKETS;
+    table->buckets = ht_unrolled_alloc_buckets(HT_UNROLLED_INIT_BUCKETS);
+    if (table->buckets == NULL) {
+        table->bucket_count = 0;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Vyhledání prvku v tabulce.
+ *
+ * Uzel nemá strukturu prvku, v případě úspěchu se proto do *entry uloží
+ * ukazatele na klíč a hodnotu v uzlu a funkce vrací entry; v opačném
+ * případě vrací hodnotu NULL. Zápis přes entry->value mění hodnotu
+ * v tabulce, ukazatele platí do další modifikace tabulky.
+ */
+ht_unrolled_entry_t *ht_unrolled_search(ht_unrolled_t *table, char *key,
+                                        ht_unrolled_entry_t *entry) {
+    uint64_t hash = ht_unrolled_hash(table, key);
+    unsigned int slot;
+    ht_unrolled_node_t *last;
+    ht_unrolled_node_t *node = ht_unrolled_find(
+        ht_unrolled_bucket(table, hash), ht_unrolled_tag(hash), key, &slot,
+        &last);
+    if (node == NULL) {
+        return NULL;
+    }
+    entry->key = node->keys[slot];
+    entry->value = &node->values[slot];
+    return entry;
+}
+
+/*
+ * Vložení nebo nalezení prvku.
+ *
+ * Pokud prvek s daným klíčem existuje, vrací ukazatel na jeho hodnotu beze
+ * změny, jinak vloží nový prvek s hodnotou value. Ukazatel je platný do
+ * další modifikace tabulky. Při nedostatku paměti vrací NULL.
+ */
+float *ht_unrolled_upsert(ht_unrolled_t *table, char *key, float value) {
+    uint64_t hash = ht_unrolled_hash(table, key);
+    uint16_t tag = ht_unrolled_tag(hash);
+    unsigned int slot;
+    ht_unrolled_node_t *last;
+    ht_unrolled_node_t *node = ht_unrolled_find(ht_unrolled_bucket(table, hash),
+                                                tag, key, &slot, &last);
+    if (node != NULL) {
+        return &node->values[slot];
+    }
+
+    size_t capacity = table->bucket_count * HT_UNROLLED_SLOTS;
+    if ((table->count + 1) * 100 > capacity * HT_UNROLLED_MAX_LOAD &&
+        ht_unrolled_rehash(table, table->bucket_count * 2)) {
+        // The chains moved, find the new end of the key's chain
+        last = ht_unrolled_bucket(table, hash);
+        while (last->next != NULL) {
+            last = last->next;
+        }
+    }
+
+    size_t length = strlen(key);
+    char *copy = malloc(length + 1);
+    if (copy == NULL) {
+        return NULL;
+    }
+    memcpy(copy, key, length + 1);
+
+    float *inserted = ht_unrolled_append(table, last, copy, value, tag);
+    if (inserted == NULL) {
+        free(copy);
+        return NULL;
+    }
+    table->count++;
+    return inserted;
+}
+
+/*
+ * Vložení nového prvku do tabulky.
+ *
+ * Pokud prvek s daným klíčem už v tabulce existuje, nahradí se jeho hodnota.
+ */
+void ht_unrolled_insert(ht_unrolled_t *table, char *key, float value) {
+    float *slot = ht_unrolled_upsert(table, key, value);
+    if (slot != NULL) {
+        *slot = value;
+    }
+}
+
+/*
+ * Získání hodnoty z tabulky.
+ *
+ * V případě úspěchu vrací funkce ukazatel na hodnotu prvku, v opačném
+ * případě hodnotu NULL.
+ */
+float *ht_unrolled_get(ht_unrolled_t *table, char *key) {
+    uint64_t hash = ht_unrolled_hash(table, key);
+    unsigned int slot;
+    ht_unrolled_node_t *last;
+    ht_unrolled_node_t *node = ht_unrolled_find(
+        ht_unrolled_bucket(table, hash), ht_unrolled_tag(hash), key, &slot,
+        &last);
+    return node != NULL ? &node->values[slot] : NULL;
+}
+
+/*
+ * Smazání prvku z tabulky. Na jeho místo se přesune poslední prvek seznamu;
+ * vyprázdněný přetékající uzel se uvolní.
+ */
+void ht_unrolled_delete(ht_unrolled_t *table, char *key) {
+    uint64_t hash = ht_unrolled_hash(table, key);
+    ht_unrolled_node_t *head = ht_unrolled_bucket(table, hash);
+    unsigned int slot;
+    ht_unrolled_node_t *last;
+    ht_unrolled_node_t *node =
+        ht_unrolled_find(head, ht_unrolled_tag(hash), key, &slot, &last);
+    if (node == NULL) {
+        return;
+    }
+
+    // The last item of the chain fills the hole
+    ht_unrolled_node_t *before = NULL;
+    last = head;
+    while (last->next != NULL) {
+        before = last;
+        last = last->next;
+    }
+    unsigned int end = ht_unrolled_used(last) - 1;
+    free(node->keys[slot]);
+    node->keys[slot] = last->keys[end];
+    node->values[slot] = last->values[end];
+    node->tags[slot] = last->tags[end];
+    last->keys[end] = NULL;
+    if (end == 0 && last != head) {
+        before->next = NULL;
+        free(last);
+        table->node_count--;
+    }
+    table->count--;
+}
+
+/*
+ * Smazání všech prvků z tabulky. Počet řádků se zachová.
+ */
+void ht_unrolled_delete_all(ht_unrolled_t *table) {
+    for (size_t b = 0; b < table->bucket_count; b++) {
+        for (ht_unrolled_node_t *node = &table->buckets[b]; node != NULL;
+             node = node->next) {
+            for (unsigned int i = 0; i < HT_UNROLLED_SLOTS; i++) {
+                free(node->keys[i]);
+            }
+        }
+    }
+    ht_unrolled_free_nodes(table->buckets, table->bucket_count);
+    memset(table->buckets, 0, table->bucket_count * sizeof(ht_unrolled_node_t));
+    table->count = 0;
+    table->node_count = 0;
+}
+
+/*
+ * Zrušení tabulky — uvolní všechny prvky i pole řádků.
+ */
+void ht_unrolled_destroy(ht_unrolled_t *table) {
+    ht_unrolled_delete_all(table);
+    free(table->buckets);
+    table->buckets = NULL;
+    table->bucket_count = 0;
+}
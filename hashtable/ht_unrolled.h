@@ -0,0 +1,63 @@
+/*
+ * Hlavičkový soubor pro zřetězenou tabulku s rozvinutými seznamy synonym.
+ *
+ * Uzel seznamu zabírá jeden řádek cache (64 B) a drží HT_UNROLLED_SLOTS
+ * prvků a jediný ukazatel na další uzel. Prvky jsou v uzlu uložené po
+ * sloupcích: ukazatele na klíče, hodnoty a 16bitové značky z hashe, podle
+ * kterých se odmítne téměř každý cizí klíč bez čtení jeho bajtů. První
+ * uzel každého seznamu leží přímo v poli řádků, další uzly se alokují až
+ * při přetečení. Průchod seznamem tak stojí jeden výpadek cache na čtyři
+ * prvky, ne na každý prvek. Klíče jsou kopie alokované zvlášť.
+ */
+
+#ifndef IAL_HT_UNROLLED_H
+#define IAL_HT_UNROLLED_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Počet prvků v uzlu: 4 klíče, hodnoty, značky a ukazatel next = 64 B
+#define HT_UNROLLED_SLOTS 4
+
+// Počáteční počet řádků (mocnina dvou)
+#define HT_UNROLLED_INIT_BUCKETS 32
+
+// Maximální zaplnění v procentech kapacity prvních uzlů
+#define HT_UNROLLED_MAX_LOAD 75
+
+// Uzel seznamu synonym, zarovnaný na řádek cache; obsazené sloty jsou
+// na začátku uzlu, všechny uzly seznamu kromě posledního jsou plné
+typedef struct ht_unrolled_node {
+  _Alignas(64) char *keys[HT_UNROLLED_SLOTS]; // kopie klíčů, NULL pro volný
+  float values[HT_UNROLLED_SLOTS];           // hodnoty prvků
+  uint16_t tags[HT_UNROLLED_SLOTS];          // horních 16 bitů hashe klíče
+  struct ht_unrolled_node *next;             // další uzel seznamu
+} ht_unrolled_node_t;
+
+// Nalezený prvek jako ukazatele do uzlu (viz ht_unrolled_search)
+typedef struct ht_unrolled_entry {
+  const char *key; // klíč v uzlu
+  float *value;    // hodnota v uzlu
+} ht_unrolled_entry_t;
+
+// Tabulka
+typedef struct ht_unrolled {
+  ht_unrolled_node_t *buckets; // pole prvních uzlů seznamů
+  size_t bucket_count;         // počet řádků (mocnina dvou)
+  size_t count;                // počet prvků
+  size_t node_count;           // počet alokovaných přetékajících uzlů
+  uint64_t seed;               // semínko rozptylovací funkce
+} ht_unrolled_t;
+
+bool ht_unrolled_init(ht_unrolled_t *table);
+ht_unrolled_entry_t *ht_unrolled_search(ht_unrolled_t *table, char *key,
+                                        ht_unrolled_entry_t *entry);
+float *ht_unrolled_upsert(ht_unrolled_t *table, char *key, float value);
+void ht_unrolled_insert(ht_unrolled_t *table, char *key, float value);
+float *ht_unrolled_get(ht_unrolled_t *table, char *key);
+void ht_unrolled_delete(ht_unrolled_t *table, char *key);
+void ht_unrolled_delete_all(ht_unrolled_t *table);
+void ht_unrolled_destroy(ht_unrolled_t *table);
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ * spolecne testy pro vsechny implementace tabulky z ht_backend.h
+ *
+ * prelozi se zvlast pro kazdou implementaci, napr.
+ * gcc -DHT_BACKEND=HT_BACKEND_SWISS ... test_backend.c
+ * (make check to udela pro vsechny)
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ht_backend.h"
+#include "test_words.h"
+
+/* kolik vygenerovanych klicu se vklada a maze */
+#define KEY_COUNT 50000
+
+#define MAX_KEY_LEN 32
+
+/* data z test.c */
+typedef struct test_pair {
+    char *key;
+    float value;
+} test_pair_t;
+
+const test_pair_t TEST_DATA[15] = {
+    {"Bitcoin", 53247.71}, {"Ethereum", 3208.67}, {"Binance Coin", 409.15},
+    {"Cardano", 1.82},     {"Tether", 0.86},      {"XRP", 0.93},
+    {"Solana", 134.50},    {"Polkadot", 34.99},   {"Dogecoin", 0.22},
+    {"USD Coin", 0.86},    {"Uniswap", 21.68},    {"Terra", 30.67},
+    {"Litecoin", 156.87},  {"Avalanche", 47.03},  {"Chainlink", 21.90}};
+
+void make_key(char *s, unsigned int i) {
+    snprintf(s, MAX_KEY_LEN, "klic%u", i);
+}
+
+/* to same co test.c, jen misto vypisu asserty */
+void test_crypto(htb_table_t *table) {
+    unsigned int count = sizeof(TEST_DATA) / sizeof(TEST_DATA[0]);
+    assert(htb_search(table, "Ethereum") == NULL);
+    for (unsigned int i = 0; i < count; i++) {
+        htb_insert(table, TEST_DATA[i].key, TEST_DATA[i].value);
+    }
+    for (unsigned int i = 0; i < count; i++) {
+        htb_entry_t *entry = htb_search(table, TEST_DATA[i].key);
+        assert(entry != NULL);
+        assert(strcmp(entry->key, TEST_DATA[i].key) == 0);
+        assert(htb_value(entry) == TEST_DATA[i].value);
+    }
+    /* vysledek vyhledani ukazuje do tabulky, dalsi vyhledani ho neprepise */
+    htb_entry_t *first = htb_search(table, TEST_DATA[0].key);
+    htb_entry_t *second = htb_search(table, TEST_DATA[1].key);
+    htb_value(first) = 1.5f;
+    assert(*htb_get(table, TEST_DATA[0].key) == 1.5f);
+    assert(strcmp(first->key, TEST_DATA[0].key) == 0);
+    assert(htb_value(second) == TEST_DATA[1].value);
+    htb_insert(table, "Ethereum", 12.34f);
+    assert(*htb_get(table, "Ethereum") == 12.34f);
+    htb_delete(table, "Terra");
+    assert(htb_search(table, "Terra") == NULL);
+    assert(htb_get(table, "Terra") == NULL);
+    htb_delete(table, "Terra");
+    assert(htb_get(table, "Bitcoin") != NULL);
+    htb_delete_all(table);
+    for (unsigned int i = 0; i < count; i++) {
+        assert(htb_search(table, TEST_DATA[i].key) == NULL);
+    }
+    printf("👍 [%s] data z test.c sedi\n", HTB_NAME);
+}
+
+/* to same co test_muj_2.c */
+void test_words(htb_table_t *table) {
+    for (unsigned int i = 0; i < word_count; i++) {
+        htb_insert(table, words[i], 0.0);
+        assert(htb_search(table, words[i]) != NULL);
+    }
+    for (unsigned int i = 0; i < word_count; i++) {
+        htb_insert(table, words[i], (float)strlen(words[i]));
+    }
+    for (unsigned int i = 0; i < word_count; i++) {
+        float *value = htb_get(table, words[i]);
+        assert(value != NULL);
+        assert(*value == (float)strlen(words[i]));
+    }
+    unsigned int quarter = word_count / 4;
+    for (unsigned int i = quarter; i < 2 * quarter; i++) {
+        htb_delete(table, words[i]);
+        assert(htb_search(table, words[i]) == NULL);
+    }
+    for (unsigned int i = 0; i < word_count; i++) {
+        bool deleted = i >= quarter && i < 2 * quarter;
+        assert((htb_get(table, words[i]) == NULL) == deleted);
+    }
+    htb_delete_all(table);
+    for (unsigned int i = 0; i < word_count; i++) {
+        assert(htb_search(table, words[i]) == NULL);
+    }
+    printf("👍 [%s] slova z test_muj_2.c sedi\n", HTB_NAME);
+}
+
+/* hodne klicu, mazani a znovu vkladani (rust tabulky, smazane sloty) */
+void test_many(htb_table_t *table) {
+    char key[MAX_KEY_LEN];
+    for (unsigned int i = 0; i < KEY_COUNT; i++) {
+        make_key(key, i);
+        htb_insert(table, key, (float)i);
+    }
+    for (unsigned int round = 0; round < 3; round++) {
+        for (unsigned int i = round % 2; i < KEY_COUNT; i += 2) {
+            make_key(key, i);
+            htb_delete(table, key);
+        }
+        for (unsigned int i = round % 2; i < KEY_COUNT; i += 2) {
+            make_key(key, i);
+            assert(htb_get(table, key) == NULL);
+            htb_insert(table, key, (float)(i + round));
+        }
+    }
+    for (unsigned int i = 0; i < KEY_COUNT; i++) {
+        make_key(key, i);
+        float *value = htb_get(table, key);
+        assert(value != NULL);
+        /* posledni prepis klice i byl v kole 2 (sude) nebo 1 (liche) */
+        assert(*value == (float)(i + (i % 2 == 0 ? 2 : 1)));
+    }
+    htb_delete_all(table);
+    make_key(key, 0);
+    assert(htb_get(table, key) == NULL);
+    printf("👍 [%s] %u klicu vlozeno, smazano a vlozeno znovu\n", HTB_NAME,
+           KEY_COUNT);
+}
+
+int main() {
+    htb_table_t *table = malloc(sizeof(htb_table_t));
+    assert(table != NULL);
+    assert(htb_init(table));
+
+    test_crypto(table);
+    test_words(table);
+    test_many(table);
+
+    htb_destroy(table);
+    free(table);
+    printf("👍 [%s] vsechny testy prosly\n", HTB_NAME);
+    return 0;
+}
@@ -0,0 +1,104 @@
+/* testy kompaktni tabulky ht_compact_t, hlavne poradi prvku a sirka indexu */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "ht_compact.h"
+
+/* tolik klicu uz potrebuje index s 32bitovymi polozkami */
+#define KEY_COUNT 100000
+
+#define MAX_KEY_LEN 32
+
+void make_key(char *s, unsigned int i) {
+    snprintf(s, MAX_KEY_LEN, "klic%u", i);
+}
+
+/* vlozi klice a hlida, ze sirka indexu roste 1 -> 2 -> 4 bajty */
+void insert_all(ht_compact_t *table) {
+    char key[MAX_KEY_LEN];
+    unsigned int last_width = table->index_width;
+    assert(last_width == 1);
+    for (unsigned int i = 0; i < KEY_COUNT; i++) {
+        make_key(key, i);
+        ht_compact_insert(table, key, (float)i);
+        assert(table->index_width >= last_width);
+        last_width = table->index_width;
+        if (table->index_size <= 256) {
+            assert(table->index_width == 1);
+        }
+    }
+    assert(table->count == KEY_COUNT);
+    assert(table->index_width == 4);
+    printf("👍 vlozeno %u klicu, index %zu polozek po %u B\n", KEY_COUNT,
+           table->index_size, table->index_width);
+}
+
+/* pruchod vraci klice v poradi vlozeni, ht_compact_next vynechava smazane */
+void check_order(ht_compact_t *table, unsigned int step) {
+    char key[MAX_KEY_LEN];
+    size_t pos = 0;
+    unsigned int expected = 0;
+    ht_compact_entry_t *entry;
+    while ((entry = ht_compact_next(table, &pos)) != NULL) {
+        make_key(key, expected);
+        assert(strcmp(entry->key, key) == 0);
+        assert(entry->value == (float)expected);
+        expected += step;
+    }
+    assert(expected / step == table->count);
+}
+
+/* smaze liche klice, prepise sude a poradi musi zustat */
+void delete_odd(ht_compact_t *table) {
+    char key[MAX_KEY_LEN];
+    for (unsigned int i = 1; i < KEY_COUNT; i += 2) {
+        make_key(key, i);
+        ht_compact_delete(table, key);
+        assert(ht_compact_search(table, key) == NULL);
+    }
+    assert(table->count == KEY_COUNT / 2);
+    /* prepsani hodnoty prvek nepresune na konec */
+    for (unsigned int i = 0; i < KEY_COUNT; i += 2) {
+        make_key(key, i);
+        ht_compact_insert(table, key, (float)i);
+    }
+    check_order(table, 2);
+    printf("👍 liche klice smazany, poradi sedi\n");
+}
+
+/* dalsi vkladani setrese smazane prvky a poradi se zachova */
+void refill(ht_compact_t *table) {
+    char key[MAX_KEY_LEN];
+    for (unsigned int i = 0; table->used != table->count; i++) {
+        make_key(key, KEY_COUNT + 2 * i);
+        ht_compact_insert(table, key, (float)(KEY_COUNT + 2 * i));
+    }
+    assert(table->used == table->count);
+    check_order(table, 2);
+    printf("👍 smazane prvky setreseny, zaplneno %zu z %zu\n", table->used,
+           table->entry_capacity);
+}
+
+int main() {
+    ht_compact_t table;
+    assert(ht_compact_init(&table));
+    assert(ht_compact_search(&table, "nic") == NULL);
+
+    insert_all(&table);
+    check_order(&table, 1);
+    printf("👍 poradi vlozeni sedi\n");
+    delete_odd(&table);
+    refill(&table);
+
+    ht_compact_delete_all(&table);
+    assert(table.count == 0);
+    size_t pos = 0;
+    assert(ht_compact_next(&table, &pos) == NULL);
+    ht_compact_insert(&table, "znovu", 1.0);
+    assert(*ht_compact_get(&table, "znovu") == 1.0);
+
+    ht_compact_destroy(&table);
+    printf("👍 vsechny testy ht_compact prosly\n");
+    return 0;
+}
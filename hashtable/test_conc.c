@@ -0,0 +1,143 @@
+/*
+ * zatezovy test ht_conc_t, nekolik vlaken najednou vklada, cte a maze
+ *
+ * pusti se v nem tri kola vlaken, kontroluje se to i behem behu
+ * (klice, ktere nikdo nemaze, musi byt porad videt)
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include "ht_conc.h"
+
+#define THREADS 8
+
+/* klicu na jedno vlakno, dohromady hodne pres HT_CONC_INIT_SIZE */
+#define KEYS_PER_THREAD 20000
+
+/* klice, ktere vkladaji vsechna vlakna soucasne */
+#define SHARED_KEYS 1000
+
+/* kolikrat kazde vlakno pricte ke kazdemu spolecnemu klici */
+#define ADD_ROUNDS 20
+
+#define MAX_KEY_LEN 32
+
+ht_conc_t table;
+
+void make_key(char *s, unsigned int thread, unsigned int i) {
+    snprintf(s, MAX_KEY_LEN, "vlakno%u_klic%u", thread, i);
+}
+
+void make_shared_key(char *s, unsigned int i) {
+    snprintf(s, MAX_KEY_LEN, "spolecny%u", i);
+}
+
+/* prvni kolo: vlastni klice, spolecne klice a cteni uz vlozenych */
+void *insert_worker(void *arg) {
+    unsigned int thread = *(unsigned int *)arg;
+    char key[MAX_KEY_LEN];
+    float value;
+    for (unsigned int i = 0; i < KEYS_PER_THREAD; i++) {
+        make_key(key, thread, i);
+        ht_conc_insert(&table, key, (float)i);
+        assert(ht_conc_get(&table, key, &value) && value == (float)i);
+
+        if (i % (KEYS_PER_THREAD / SHARED_KEYS) == 0) {
+            unsigned int shared = i / (KEYS_PER_THREAD / SHARED_KEYS);
+            make_shared_key(key, shared);
+            ht_conc_insert(&table, key, (float)shared);
+        }
+        if (i > 0) {
+            make_key(key, thread, i / 2);
+            assert(ht_conc_get(&table, key, &value) && value == (float)(i / 2));
+        }
+    }
+    return NULL;
+}
+
+/* druhe kolo: mazani lichych vlastnich klicu a cteni cizich sudych */
+void *delete_worker(void *arg) {
+    unsigned int thread = *(unsigned int *)arg;
+    unsigned int other = (thread + 1) % THREADS;
+    char key[MAX_KEY_LEN];
+    float value;
+    for (unsigned int i = 1; i < KEYS_PER_THREAD; i += 2) {
+        make_key(key, thread, i);
+        ht_conc_delete(&table, key);
+        assert(!ht_conc_get(&table, key, &value));
+
+        make_key(key, other, i - 1);
+        assert(ht_conc_get(&table, key, &value) && value == (float)(i - 1));
+    }
+    return NULL;
+}
+
+/* treti kolo: vsechna vlakna zaroven pricitaji ke spolecnym klicum */
+void *add_worker(void *arg) {
+    (void)arg;
+    char key[MAX_KEY_LEN];
+    for (unsigned int round = 0; round < ADD_ROUNDS; round++) {
+        for (unsigned int i = 0; i < SHARED_KEYS; i++) {
+            make_shared_key(key, i);
+            ht_conc_add(&table, key, 1.0);
+        }
+    }
+    return NULL;
+}
+
+void run_threads(void *(*worker)(void *)) {
+    pthread_t threads[THREADS];
+    unsigned int ids[THREADS];
+    for (unsigned int t = 0; t < THREADS; t++) {
+        ids[t] = t;
+        assert(pthread_create(&threads[t], NULL, worker, &ids[t]) == 0);
+    }
+    for (unsigned int t = 0; t < THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+}
+
+int main() {
+    char key[MAX_KEY_LEN];
+    float value;
+    assert(ht_conc_init(&table));
+
+    run_threads(insert_worker);
+    assert(ht_conc_count(&table) == THREADS * KEYS_PER_THREAD + SHARED_KEYS);
+    assert(table.size > HT_CONC_INIT_SIZE);
+    for (unsigned int i = 0; i < SHARED_KEYS; i++) {
+        make_shared_key(key, i);
+        assert(ht_conc_get(&table, key, &value) && value == (float)i);
+    }
+    printf("👍 %u vlaken vlozilo %zu klicu, velikost pole %zu\n", THREADS,
+           ht_conc_count(&table), table.size);
+
+    run_threads(delete_worker);
+    assert(ht_conc_count(&table) ==
+           THREADS * KEYS_PER_THREAD / 2 + SHARED_KEYS);
+    for (unsigned int t = 0; t < THREADS; t++) {
+        for (unsigned int i = 0; i < KEYS_PER_THREAD; i++) {
+            make_key(key, t, i);
+            assert(ht_conc_get(&table, key, &value) == (i % 2 == 0));
+        }
+    }
+    printf("👍 liche klice smazany, sude zustaly\n");
+
+    run_threads(add_worker);
+    for (unsigned int i = 0; i < SHARED_KEYS; i++) {
+        make_shared_key(key, i);
+        assert(ht_conc_get(&table, key, &value) &&
+               value == (float)(i + THREADS * ADD_ROUNDS));
+    }
+    printf("👍 soubezna pricitani se neztratila\n");
+
+    ht_conc_delete_all(&table);
+    assert(ht_conc_count(&table) == 0);
+    make_shared_key(key, 0);
+    assert(!ht_conc_get(&table, key, &value));
+
+    ht_conc_destroy(&table);
+    printf("👍 vsechny testy ht_conc prosly\n");
+    return 0;
+}
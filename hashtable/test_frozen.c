@@ -0,0 +1,161 @@
+/*
+ * testy zmrazene tabulky ht_frozen_t
+ *
+ * zmrazi se ht_map_t s hodne klici i ht_table_t se slovy z test_words.c
+ * a kontroluje se, ze kazdy klic ma svoji hodnotu, chybejici klice se
+ * nenajdou a kazda pozice patri prave jednomu klici; zmrazena tabulka se
+ * ulozi do souboru a znovu nacte
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "ht_frozen.h"
+#include "test_words.h"
+
+/* kolik klicu se da do ht_map_t */
+#define KEY_COUNT 200000
+
+#define MAX_KEY_LEN 32
+
+void make_key(char *s, unsigned int i) {
+    snprintf(s, MAX_KEY_LEN, "klic%u", i);
+}
+
+void test_map(void) {
+    ht_map_t map;
+    ht_frozen_t frozen;
+    char key[MAX_KEY_LEN];
+    assert(ht_map_init(&map));
+    for (unsigned int i = 0; i < KEY_COUNT; i++) {
+        make_key(key, i);
+        ht_map_insert(&map, key, (float)i);
+    }
+    /* par klicu navic, at je tabulka zrovna uprostred presouvani */
+    for (unsigned int i = KEY_COUNT; map.old_buckets == NULL; i++) {
+        make_key(key, i);
+        ht_map_insert(&map, key, (float)i);
+    }
+    assert(ht_map_freeze(&frozen, &map));
+    assert(frozen.count == map.count);
+
+    for (unsigned int i = 0; i < map.count; i++) {
+        make_key(key, i);
+        float *value = ht_frozen_get(&frozen, key);
+        assert(value != NULL && *value == (float)i);
+    }
+    for (unsigned int i = 0; i < KEY_COUNT; i++) {
+        snprintf(key, MAX_KEY_LEN, "chybi%u", i);
+        assert(ht_frozen_get(&frozen, key) == NULL);
+    }
+    /* pozice jsou husto a kazda vede zpatky na svuj klic */
+    for (size_t p = 0; p < frozen.count; p++) {
+        const char *stored = ht_frozen_key(&frozen, p);
+        assert(ht_frozen_get(&frozen, (char *)stored) == &frozen.values[p]);
+    }
+    printf("👍 zmrazeno %zu klicu, posunuti po %u B, %.2f bitu na klic\n",
+           frozen.count, frozen.width,
+           8.0 * (double)(frozen.bucket_count * frozen.width +
+                          (frozen.slot_count - frozen.count) * 4) /
+               (double)frozen.count);
+
+    /* zmrazena tabulka nezavisi na puvodni */
+    ht_map_destroy(&map);
+    assert(*ht_frozen_get(&frozen, "klic7") == 7.0);
+    ht_frozen_destroy(&frozen);
+}
+
+void test_table(void) {
+    ht_table_t table;
+    ht_frozen_t frozen;
+    ht_init(&table);
+
+    /* prazdna tabulka */
+    assert(ht_freeze(&frozen, &table));
+    assert(frozen.count == 0);
+    assert(ht_frozen_get(&frozen, words[0]) == NULL);
+    ht_frozen_destroy(&frozen);
+
+    for (unsigned int i = 0; i < word_count; i++) {
+        ht_insert(&table, words[i], (float)strlen(words[i]));
+    }
+    assert(ht_freeze(&frozen, &table));
+    assert(frozen.count == word_count);
+    for (unsigned int i = 0; i < word_count; i++) {
+        float *value = ht_frozen_get(&frozen, words[i]);
+        assert(value != NULL && *value == (float)strlen(words[i]));
+    }
+    assert(ht_frozen_get(&frozen, "") == NULL);
+    /* klic jako usek delsiho retezce */
+    size_t length = strlen(words[0]);
+    char longer[256];
+    snprintf(longer, sizeof(longer), "%s-konec", words[0]);
+    assert(ht_frozen_get_n(&frozen, longer, length) ==
+           ht_frozen_get(&frozen, words[0]));
+    assert(ht_frozen_get_n(&frozen, longer, length + 1) == NULL);
+    ht_frozen_destroy(&frozen);
+    ht_delete_all(&table);
+    printf("👍 ht_table_t se slovy z test_words.c zmrazena\n");
+}
+
+void test_snapshot(void) {
+    ht_table_t table;
+    ht_frozen_t frozen, loaded;
+    char path[] = "/tmp/test_frozen_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    ht_init(&table);
+    for (unsigned int i = 0; i < word_count; i++) {
+        ht_insert(&table, words[i], (float)i);
+    }
+    assert(ht_freeze(&frozen, &table));
+    assert(ht_frozen_save(&frozen, path));
+    assert(ht_frozen_load(&loaded, path));
+    assert(loaded.mapped && loaded.count == frozen.count);
+    assert(loaded.memory_size == frozen.memory_size);
+    assert(memcmp(loaded.memory, frozen.memory, frozen.memory_size) == 0);
+    for (unsigned int i = 0; i < word_count; i++) {
+        float *value = ht_frozen_get(&loaded, words[i]);
+        assert(value != NULL && *value == *ht_get(&table, words[i]));
+    }
+    assert(ht_frozen_get(&loaded, "chybi") == NULL);
+    /* zapis do nactene tabulky soubor nezmeni */
+    *ht_frozen_get(&loaded, words[0]) = -1.0;
+    ht_frozen_destroy(&loaded);
+    assert(ht_frozen_load(&loaded, path));
+    assert(*ht_frozen_get(&loaded, words[0]) == *ht_get(&table, words[0]));
+    ht_frozen_destroy(&loaded);
+
+    /* oriznuty soubor se odmitne */
+    assert(truncate(path, (off_t)frozen.memory_size) == 0);
+    assert(!ht_frozen_load(&loaded, path));
+    assert(loaded.memory == NULL);
+    unlink(path);
+    assert(!ht_frozen_load(&loaded, path));
+
+    /* prazdna tabulka */
+    ht_frozen_destroy(&frozen);
+    ht_delete_all(&table);
+    assert(ht_freeze(&frozen, &table));
+    assert(ht_frozen_save(&frozen, path));
+    assert(ht_frozen_load(&loaded, path));
+    assert(loaded.count == 0 && ht_frozen_get(&loaded, words[0]) == NULL);
+    ht_frozen_destroy(&loaded);
+    ht_frozen_destroy(&frozen);
+    unlink(path);
+    printf("👍 zmrazena tabulka ulozena a namapovana zpet\n");
+}
+
+int main() {
+    test_map();
+    test_table();
+    test_snapshot();
+    printf("👍 vsechny testy ht_frozen prosly\n");
+    return 0;
+}
@@ -0,0 +1,264 @@
+/*
+ * testy tabulky ht_handle_t s vlastni velikosti, rozptylovaci funkci
+ * a alokatorem
+ *
+ * nekolik tabulek ruznych velikosti bezi vedle sebe se slovy
+ * z test_words.c a porovnava se s ht_map_t; tabulka s vychozim nastavenim
+ * musi mit stejne seznamy synonym jako ht_table_t; samoorganizujici
+ * seznamy (move-to-front, transpozice) meni jen poradi v radku
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "ht_arena.h"
+#include "ht_map.h"
+#include "test_words.h"
+
+/* velikosti tabulek: jeden radek, prvocisla, mocniny dvojky, obecne */
+static const size_t SIZES[] = {1, 2, 13, 64, 101, 1000, 4096, 65521};
+#define SIZE_COUNT (sizeof(SIZES) / sizeof(SIZES[0]))
+
+/* kazdy prvek lezi v radku, ktery mu patri, a nikde jinde */
+void check_rows(ht_handle_t *table) {
+    for (size_t r = 0; r < table->size; r++) {
+        for (ht_item_t *item = table->buckets[r]; item != NULL;
+             item = item->next) {
+            if (table->shift == 0) {
+                assert(item->hash % table->size == r);
+            }
+            assert(ht_handle_search(table, item->key) == item);
+        }
+    }
+}
+
+/* tabulka ma presne klice a hodnoty z reference */
+void check_same(ht_handle_t *table, ht_map_t *expected) {
+    size_t items = 0;
+    for (size_t r = 0; r < table->size; r++) {
+        for (ht_item_t *item = table->buckets[r]; item != NULL;
+             item = item->next) {
+            float *value = ht_map_get(expected, item->key);
+            assert(value != NULL && *value == item->value);
+            items++;
+        }
+    }
+    assert(items == expected->count);
+    check_rows(table);
+}
+
+void side_by_side(void) {
+    ht_handle_t tables[SIZE_COUNT];
+    ht_map_t expected;
+    assert(ht_map_init(&expected));
+    for (size_t t = 0; t < SIZE_COUNT; t++) {
+        ht_handle_config_t config = {.size = SIZES[t]};
+        assert(ht_handle_init(&tables[t], &config));
+        assert(tables[t].size == SIZES[t]);
+    }
+    /* prokladane vkladani do vsech tabulek najednou */
+    for (unsigned int i = 0; i < word_count; i++) {
+        for (size_t t = 0; t < SIZE_COUNT; t++) {
+            ht_handle_insert(&tables[t], words[i], (float)i);
+        }
+        ht_map_insert(&expected, words[i], (float)i);
+    }
+    for (unsigned int i = 0; i < word_count; i += 2) {
+        char *doomed = words[i + 1 < word_count ? i + 1 : i];
+        for (size_t t = 0; t < SIZE_COUNT; t++) {
+            ht_handle_increment(&tables[t], words[i]);
+            ht_handle_delete(&tables[t], doomed);
+        }
+        ht_map_increment(&expected, words[i]);
+        ht_map_delete(&expected, doomed);
+    }
+    for (size_t t = 0; t < SIZE_COUNT; t++) {
+        check_same(&tables[t], &expected);
+        ht_handle_destroy(&tables[t]);
+        assert(tables[t].buckets == NULL);
+    }
+    ht_map_destroy(&expected);
+    printf("👍 %zu tabulek ruznych velikosti vedle sebe\n", SIZE_COUNT);
+}
+
+/* vychozi ht_handle_t se chova jako ht_table_t s HT_SIZE == MAX_HT_SIZE */
+void same_as_table(void) {
+    ht_table_t table;
+    ht_handle_t handle;
+    ht_init(&table);
+    assert(ht_handle_init(&handle, NULL));
+    assert(handle.size == MAX_HT_SIZE && HT_SIZE == MAX_HT_SIZE);
+    for (unsigned int i = 0; i < word_count; i++) {
+        ht_insert(&table, words[i], (float)i);
+        ht_handle_insert(&handle, words[i], (float)i);
+        ht_item_t *item = ht_handle_search(&handle, words[i]);
+        assert(get_hash(words[i]) == (int)(item->hash % MAX_HT_SIZE));
+    }
+    for (int r = 0; r < MAX_HT_SIZE; r++) {
+        ht_item_t *a = table[r];
+        ht_item_t *b = handle.buckets[r];
+        for (; a != NULL && b != NULL; a = a->next, b = b->next) {
+            assert(strcmp(a->key, b->key) == 0 && a->value == b->value);
+        }
+        assert(a == NULL && b == NULL);
+    }
+    ht_delete_all(&table);
+    ht_handle_destroy(&handle);
+    printf("👍 vychozi ht_handle_t ma stejne seznamy jako ht_table_t\n");
+}
+
+/* vlastni rozptylovaci funkce se seminkem a prvky v arene */
+void custom_hash_arena(void) {
+    ht_arena_t arena;
+    ht_arena_init(&arena);
+    ht_handle_config_t config = {.size = 1024,
+                                 .seed = 12345,
+                                 .hash = ht_hash_wy,
+                                 .allocator = ht_arena_allocator(&arena)};
+    ht_handle_t table;
+    ht_map_t expected;
+    assert(ht_handle_init(&table, &config));
+    assert(ht_map_init(&expected));
+
+    static ht_item_t items[1000];
+    int count = word_count < 1000 ? (int)word_count : 1000;
+    for (int i = 0; i < count; i++) {
+        items[i].key = words[i];
+        items[i].value = (float)(i % 7);
+        ht_map_insert(&expected, words[i], (float)(i % 7));
+    }
+    ht_handle_insert_many(&table, items, count);
+    check_same(&table, &expected);
+    /* jine seminko dava jiny hash nez vychozi tabulka */
+    assert(ht_handle_search(&table, words[0])->hash !=
+           ht_hash_fold(ht_hash_wy(words[0], strlen(words[0]), 0)));
+
+    char *keys[1000];
+    float *values[1000];
+    for (int i = 0; i < count; i++) {
+        keys[i] = words[i];
+    }
+    ht_handle_get_batch(&table, keys, (size_t)count, values);
+    for (int i = 0; i < count; i++) {
+        assert(values[i] == ht_handle_get(&table, keys[i]));
+    }
+    ht_handle_delete_many(&table, keys, count / 2);
+    for (int i = 0; i < count / 2; i++) {
+        ht_map_delete(&expected, keys[i]);
+    }
+    check_same(&table, &expected);
+
+    ht_handle_destroy(&table);
+    ht_map_destroy(&expected);
+    ht_arena_destroy(&arena);
+    printf("👍 vlastni rozptylovaci funkce a prvky v arene\n");
+}
+
+/* pozice prvku s klicem key v jeho radku, -1 kdyz tam neni */
+int position(ht_handle_t *table, size_t row, char *key) {
+    int p = 0;
+    for (ht_item_t *item = table->buckets[row]; item != NULL;
+         item = item->next, p++) {
+        if (strcmp(item->key, key) == 0) {
+            return p;
+        }
+    }
+    return -1;
+}
+
+/* radek, ve kterem lezi klic key */
+size_t row_of(ht_handle_t *table, char *key) {
+    for (size_t r = 0; r < table->size; r++) {
+        if (position(table, r, key) >= 0) {
+            return r;
+        }
+    }
+    assert(0);
+    return 0;
+}
+
+/* move-to-front a transpozice presouvaji jen v ramci radku */
+void policies(void) {
+    ht_policy_t policies[] = {HT_POLICY_MOVE_TO_FRONT, HT_POLICY_TRANSPOSE};
+    for (int p = 0; p < 2; p++) {
+        ht_handle_config_t config = {.size = 13, .policy = policies[p]};
+        ht_handle_t table;
+        ht_map_t expected;
+        assert(ht_handle_init(&table, &config));
+        assert(ht_map_init(&expected));
+        for (unsigned int i = 0; i < word_count; i++) {
+            ht_handle_insert(&table, words[i], (float)i);
+            ht_map_insert(&expected, words[i], (float)i);
+        }
+        /* prvni vlozeny klic je na konci sveho radku */
+        char *key = words[0];
+        size_t row = row_of(&table, key);
+        int before = position(&table, row, key);
+        assert(before > 1);
+        assert(ht_handle_search(&table, key)->value == 0.0f);
+        int after = position(&table, row, key);
+        if (policies[p] == HT_POLICY_MOVE_TO_FRONT) {
+            assert(after == 0);
+        } else {
+            assert(after == before - 1);
+            assert(*ht_handle_get(&table, key) == 0.0f);
+            assert(position(&table, row, key) == before - 2);
+        }
+        /* prvni prvek radku zustava na miste */
+        char *head = table.buckets[row]->key;
+        ht_handle_search(&table, head);
+        assert(table.buckets[row]->key == head);
+
+        /* hledani, upsert a mazani s presouvanim drzi obsah tabulky */
+        for (unsigned int i = 0; i < word_count; i += 3) {
+            ht_handle_increment(&table, words[i]);
+            ht_map_increment(&expected, words[i]);
+            assert(ht_handle_search(&table, words[i / 2]) != NULL);
+        }
+        for (unsigned int i = 0; i < word_count; i += 4) {
+            ht_handle_delete(&table, words[i]);
+            ht_map_delete(&expected, words[i]);
+        }
+        /* ht_handle_insert_many presouva stejne jako vkladani po jednom */
+        ht_handle_t single, many;
+        assert(ht_handle_init(&single, &config));
+        assert(ht_handle_init(&many, &config));
+        for (unsigned int i = 0; i < word_count / 2; i++) {
+            ht_handle_insert(&single, words[i], (float)i);
+            ht_handle_insert(&many, words[i], (float)i);
+        }
+        static ht_item_t batch[600];
+        for (unsigned int i = 0; i < 600; i++) {
+            batch[i].key = words[i * 7 % word_count];
+            batch[i].value = (float)i;
+            ht_handle_insert(&single, batch[i].key, batch[i].value);
+        }
+        ht_handle_insert_many(&many, batch, 600);
+        for (size_t r = 0; r < single.size; r++) {
+            ht_item_t *a = single.buckets[r];
+            ht_item_t *b = many.buckets[r];
+            for (; a != NULL && b != NULL; a = a->next, b = b->next) {
+                assert(strcmp(a->key, b->key) == 0 && a->value == b->value);
+            }
+            assert(a == NULL && b == NULL);
+        }
+        ht_handle_destroy(&single);
+        ht_handle_destroy(&many);
+
+        /* check_rows hleda pri pruchodu radky, ty se uz nesmi menit */
+        table.policy = HT_POLICY_NONE;
+        check_same(&table, &expected);
+        ht_handle_destroy(&table);
+        ht_map_destroy(&expected);
+    }
+    printf("👍 move-to-front a transpozice v seznamech synonym\n");
+}
+
+int main() {
+    side_by_side();
+    same_as_table();
+    custom_hash_arena();
+    policies();
+    printf("👍 vsechny testy ht_handle prosly\n");
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*
+ * zatezovy test ht_lf_t, ctenari bez zamku bezi proti zapisujicim vlaknum
+ *
+ * zapisujici vlakna vkladaji stale klice (tabulka se pritom nekolikrat
+ * zvetsi) a porad dokola vkladaji a mazou docasne klice; ctenari mezitim
+ * kontroluji, ze uz vlozene stale klice vidi a ze docasny klic ma bud
+ * spravnou hodnotu, nebo tam neni. pouziti uvolneneho prvku odhali
+ * prelozeni s -fsanitize=address
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include "ht_lf.h"
+
+#define WRITERS 2
+#define READERS 4
+
+/* stalych klicu na jedno zapisujici vlakno, sudy nasobek CHURN_KEYS,
+ * aby posledni kolo docasne klice smazalo */
+#define STABLE_KEYS 20480
+
+/* docasnych klicu na jedno zapisujici vlakno */
+#define CHURN_KEYS 64
+
+/* citacu, ke kterym vsechna zapisujici vlakna pricitaji, a kolikrat */
+#define COUNTERS 256
+#define ADD_ROUNDS 50
+
+#define MAX_KEY_LEN 32
+
+ht_lf_t table;
+
+/* kolik stalych klicu uz ma kazde zapisujici vlakno vlozeno */
+atomic_uint published[WRITERS];
+
+atomic_bool writers_done;
+
+void make_key(char *s, unsigned int writer, unsigned int i) {
+    snprintf(s, MAX_KEY_LEN, "staly%u_%u", writer, i);
+}
+
+void make_churn_key(char *s, unsigned int writer, unsigned int i) {
+    snprintf(s, MAX_KEY_LEN, "docasny%u_%u", writer, i);
+}
+
+void *writer(void *arg) {
+    unsigned int id = *(unsigned int *)arg;
+    char key[MAX_KEY_LEN];
+    for (unsigned int i = 0; i < STABLE_KEYS; i++) {
+        make_key(key, id, i);
+        ht_lf_insert(&table, key, (float)i);
+        atomic_store(&published[id], i + 1);
+
+        make_churn_key(key, id, i % CHURN_KEYS);
+        if (i / CHURN_KEYS % 2 == 0) {
+            ht_lf_insert(&table, key, (float)(i % CHURN_KEYS));
+        } else {
+            ht_lf_delete(&table, key);
+        }
+    }
+    return NULL;
+}
+
+void *reader(void *arg) {
+    unsigned int id = *(unsigned int *)arg;
+    char key[MAX_KEY_LEN];
+    float value;
+    unsigned long reads = 0;
+    while (!atomic_load(&writers_done)) {
+        for (unsigned int w = 0; w < WRITERS; w++) {
+            unsigned int count = atomic_load(&published[w]);
+            if (count > 0) {
+                unsigned int i = (unsigned int)(reads * 7919 + id) % count;
+                make_key(key, w, i);
+                assert(ht_lf_get(&table, key, &value));
+                assert(value == (float)i);
+            }
+            unsigned int c = (unsigned int)(reads + id) % CHURN_KEYS;
+            make_churn_key(key, w, c);
+            if (ht_lf_get(&table, key, &value)) {
+                assert(value == (float)c);
+            }
+            reads++;
+        }
+    }
+    return NULL;
+}
+
+void *counter(void *arg) {
+    (void)arg;
+    char key[MAX_KEY_LEN];
+    for (unsigned int round = 0; round < ADD_ROUNDS; round++) {
+        for (unsigned int i = 0; i < COUNTERS; i++) {
+            snprintf(key, MAX_KEY_LEN, "citac%u", i);
+            ht_lf_add(&table, key, 1.0);
+        }
+    }
+    return NULL;
+}
+
+int main() {
+    pthread_t writers[WRITERS], readers[READERS];
+    unsigned int ids[WRITERS + READERS];
+    assert(ht_lf_init(&table));
+
+    for (unsigned int t = 0; t < READERS; t++) {
+        ids[WRITERS + t] = t;
+        assert(pthread_create(&readers[t], NULL, reader, &ids[WRITERS + t]) == 0);
+    }
+    for (unsigned int t = 0; t < WRITERS; t++) {
+        ids[t] = t;
+        assert(pthread_create(&writers[t], NULL, writer, &ids[t]) == 0);
+    }
+    for (unsigned int t = 0; t < WRITERS; t++) {
+        pthread_join(writers[t], NULL);
+    }
+    atomic_store(&writers_done, true);
+    for (unsigned int t = 0; t < READERS; t++) {
+        pthread_join(readers[t], NULL);
+    }
+
+    ht_lf_array_t *array = atomic_load(&table.array);
+    assert(array->size > HT_LF_INIT_SIZE);
+    printf("👍 %u ctenaru bezelo proti %u zapisujicim, velikost pole %zu\n",
+           READERS, WRITERS, array->size);
+
+    char key[MAX_KEY_LEN];
+    float value;
+    size_t churn = 0;
+    for (unsigned int w = 0; w < WRITERS; w++) {
+        for (unsigned int i = 0; i < STABLE_KEYS; i++) {
+            make_key(key, w, i);
+            assert(ht_lf_get(&table, key, &value) && value == (float)i);
+        }
+        for (unsigned int c = 0; c < CHURN_KEYS; c++) {
+            make_churn_key(key, w, c);
+            churn += ht_lf_get(&table, key, &value);
+        }
+    }
+    assert(churn == 0);
+    assert(ht_lf_count(&table) == WRITERS * STABLE_KEYS);
+    printf("👍 stale klice vsechny nalezeny, docasne smazany\n");
+
+    for (unsigned int t = 0; t < WRITERS; t++) {
+        assert(pthread_create(&writers[t], NULL, counter, NULL) == 0);
+    }
+    for (unsigned int t = 0; t < WRITERS; t++) {
+        pthread_join(writers[t], NULL);
+    }
+    for (unsigned int i = 0; i < COUNTERS; i++) {
+        snprintf(key, MAX_KEY_LEN, "citac%u", i);
+        assert(ht_lf_get(&table, key, &value) &&
+               value == (float)(WRITERS * ADD_ROUNDS));
+    }
+    printf("👍 soubezna pricitani se neztratila\n");
+
+    ht_lf_delete_all(&table);
+    assert(ht_lf_count(&table) == 0);
+    make_key(key, 0, 0);
+    assert(!ht_lf_get(&table, key, &value));
+
+    ht_lf_destroy(&table);
+    printf("👍 vsechny testy ht_lf prosly\n");
+    return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ * testy hromadneho nacitani ht_load_*
+ *
+ * text ze slov z test_words.c s ruznymi bilymi znaky se nacte jednim
+ * i vice vlakny a pocty vyskytu se porovnaji s pocitanim v ht_map_t
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "ht_load.h"
+#include "test_words.h"
+
+/* kolikrat se seznam slov v textu zopakuje */
+#define ROUNDS 5
+
+static const char *SEPARATORS[] = {" ", "\n", "\t", "  \r\n", "\v\f"};
+
+/* slozi text ze slov, slovo i se v kole r objevi jen kdyz i % (r+1) == 0 */
+char *make_text(size_t *size, ht_map_t *expected) {
+    size_t capacity = 0;
+    for (unsigned int i = 0; i < word_count; i++) {
+        capacity += strlen(words[i]) + 4;
+    }
+    capacity = capacity * ROUNDS + 1;
+    char *text = malloc(capacity);
+    assert(text != NULL);
+
+    char *p = text;
+    for (unsigned int r = 0; r < ROUNDS; r++) {
+        for (unsigned int i = 0; i < word_count; i += r + 1) {
+            size_t length = strlen(words[i]);
+            memcpy(p, words[i], length);
+            p += length;
+            const char *sep = SEPARATORS[(i + r) % 5];
+            memcpy(p, sep, strlen(sep));
+            p += strlen(sep);
+            (*ht_map_upsert(expected, words[i], 0.0))++;
+        }
+    }
+    *size = (size_t)(p - text);
+    return text;
+}
+
+void check_counts(ht_shard_t *table, ht_map_t *expected) {
+    assert(ht_shard_count(table) == expected->count);
+    for (unsigned int i = 0; i < word_count; i++) {
+        float *count = ht_shard_get(table, words[i]);
+        assert(count != NULL);
+        assert(*count == *ht_map_get(expected, words[i]));
+    }
+}
+
+void test_buffer(const char *text, size_t size, ht_map_t *expected,
+                 unsigned int threads) {
+    ht_shard_t table;
+    assert(ht_shard_init(&table));
+    size_t words_read;
+    assert(ht_load_buffer(&table, text, size, threads, &words_read));
+    size_t total = 0;
+    for (unsigned int i = 0; i < word_count; i++) {
+        total += (size_t)*ht_map_get(expected, words[i]);
+    }
+    assert(words_read == total);
+    check_counts(&table, expected);
+    ht_shard_destroy(&table);
+    printf("👍 %zu slov nacteno %u vlakny\n", words_read, threads);
+}
+
+void test_file(const char *text, size_t size, ht_map_t *expected) {
+    char path[] = "/tmp/test_load_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    assert(write(fd, text, size) == (ssize_t)size);
+    close(fd);
+
+    ht_shard_t table;
+    size_t words_read;
+    assert(ht_shard_init(&table));
+    assert(ht_load_file(&table, path, 3, &words_read));
+    check_counts(&table, expected);
+    unlink(path);
+    assert(!ht_load_file(&table, path, 3, &words_read));
+    ht_shard_destroy(&table);
+    printf("👍 soubor nacten pres mmap\n");
+}
+
+/* prilis dlouhe slovo se rozdeli jako v read_word */
+void test_long_word(void) {
+    char text[HT_LOAD_MAX_WORD + 10];
+    memset(text, 'a', sizeof(text));
+    ht_shard_t table;
+    assert(ht_shard_init(&table));
+    size_t words_read;
+    assert(ht_load_buffer(&table, text, sizeof(text), 1, &words_read));
+    assert(words_read == 2);
+    text[HT_LOAD_MAX_WORD - 1] = '\0';
+    assert(ht_shard_get(&table, text) != NULL);
+    assert(ht_shard_get(&table, "aaaaaaaaaaa") != NULL);
+    ht_shard_destroy(&table);
+    printf("👍 dlouhe slovo rozdeleno\n");
+}
+
+/* buffer jen s bilymi znaky je uspesne nacteni nula slov */
+void test_blank(void) {
+    const char text[] = " \n\t \n";
+    ht_shard_t table;
+    assert(ht_shard_init(&table));
+    size_t words_read = 1;
+    assert(ht_load_buffer(&table, text, sizeof(text) - 1, 2, &words_read));
+    assert(words_read == 0 && ht_shard_count(&table) == 0);
+    ht_shard_destroy(&table);
+    printf("👍 prazdny vstup neni chyba\n");
+}
+
+int main() {
+    ht_map_t expected;
+    assert(ht_map_init(&expected));
+    size_t size;
+    char *text = make_text(&size, &expected);
+
+    test_buffer(text, size, &expected, 1);
+    test_buffer(text, size, &expected, 3);
+    test_buffer(text, size, &expected, 7);
+    test_file(text, size, &expected);
+    test_long_word();
+    test_blank();
+
+    free(text);
+    ht_map_destroy(&expected);
+    printf("👍 vsechny testy ht_load prosly\n");
+    return 0;
+}
@@ -0,0 +1,329 @@
+/* testy rostouci tabulky ht_map_t, zase hromada assertu */
+
+#include <assert.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "ht_map.h"
+
+/* kolik klicu se do tabulky nacpe (hodne pres MAX_HT_SIZE) */
+#define KEY_COUNT 100000
+
+#define MAX_KEY_LEN 32
+
+/* vyrobi i-ty klic */
+void make_key(char *s, unsigned int i) {
+    snprintf(s, MAX_KEY_LEN, "slovo%u", i);
+}
+
+/* ht_map_search_batch a ht_map_get_batch musi najit to same jako
+ * jednotlive ht_map_search, i pro chybejici klice a behem presouvani */
+void check_batch(ht_map_t *map, unsigned int count) {
+    static char storage[KEY_COUNT + 3][MAX_KEY_LEN];
+    static char *keys[KEY_COUNT + 3];
+    static ht_item_t *items[KEY_COUNT + 3];
+    static float *values[KEY_COUNT + 3];
+    /* par klicu navic, ktere v tabulce nikdy nejsou */
+    for (unsigned int i = 0; i < count + 3; i++) {
+        make_key(storage[i], i < count ? i : KEY_COUNT + i);
+        keys[i] = storage[i];
+    }
+    ht_map_search_batch(map, keys, count + 3, items);
+    ht_map_get_batch(map, keys, count + 3, values);
+    for (unsigned int i = 0; i < count + 3; i++) {
+        ht_item_t *item = ht_map_search(map, keys[i]);
+        assert(items[i] == item);
+        assert(values[i] == (item != NULL ? &item->value : NULL));
+    }
+}
+
+/* da tam vsechny klice a hned kontroluje ze tam jsou */
+void insert_all(ht_map_t *map) {
+    char key[MAX_KEY_LEN];
+    int seen_migration = 0;
+    for (unsigned int i = 0; i < KEY_COUNT; i++) {
+        make_key(key, i);
+        ht_map_insert(map, key, (float)i);
+        assert(ht_map_search(map, key) != NULL);
+
+        /* behem presouvani musi byt dohledatelne i stare klice */
+        if (map->old_buckets != NULL && !seen_migration) {
+            seen_migration = 1;
+            char old[MAX_KEY_LEN];
+            for (unsigned int j = 0; j <= i; j++) {
+                make_key(old, j);
+                float *value = ht_map_get(map, old);
+                assert(value != NULL);
+                assert(*value == (float)j);
+            }
+            check_batch(map, i + 1);
+        }
+    }
+    assert(seen_migration);
+    assert(map->count == KEY_COUNT);
+    assert(map->size > KEY_COUNT / HT_MAP_MAX_LOAD / 2);
+    /* pole z ht_map_init_pow2 zustava mocninou dvojky */
+    assert(map->shift == 0 || map->size == (size_t)1 << (64 - map->shift));
+    printf("👍 vlozeno %u klicu, velikost pole %zu\n", KEY_COUNT, map->size);
+}
+
+/* prepise hodnoty a zkontroluje ze se nic nezdvojilo */
+void update_all(ht_map_t *map) {
+    char key[MAX_KEY_LEN];
+    for (unsigned int i = 0; i < KEY_COUNT; i++) {
+        make_key(key, i);
+        ht_map_insert(map, key, (float)(2 * i));
+    }
+    assert(map->count == KEY_COUNT);
+    for (unsigned int i = 0; i < KEY_COUNT; i++) {
+        make_key(key, i);
+        float *value = ht_map_get(map, key);
+        assert(value != NULL);
+        assert(*value == (float)(2 * i));
+    }
+    printf("👍 hodnoty prepsany\n");
+}
+
+/* smaze sude klice */
+void delete_even(ht_map_t *map) {
+    char key[MAX_KEY_LEN];
+    for (unsigned int i = 0; i < KEY_COUNT; i += 2) {
+        make_key(key, i);
+        ht_map_delete(map, key);
+        assert(ht_map_search(map, key) == NULL);
+    }
+    assert(map->count == KEY_COUNT / 2);
+    for (unsigned int i = 1; i < KEY_COUNT; i += 2) {
+        make_key(key, i);
+        assert(ht_map_get(map, key) != NULL);
+    }
+    /* mazani neexistujiciho klice nic nedela */
+    ht_map_delete(map, "neni tam");
+    assert(map->count == KEY_COUNT / 2);
+    check_batch(map, KEY_COUNT);
+    printf("👍 smazana polovina klicu\n");
+}
+
+/* pocita vyskyty pres ht_map_upsert, i kdyz se tabulka mezitim zvetsuje */
+void count_upsert(ht_map_t *map) {
+    char key[MAX_KEY_LEN];
+    for (unsigned int i = 0; i < KEY_COUNT; i++) {
+        /* klic i se objevi (i % 3) + 1 krat */
+        for (unsigned int j = 0; j <= i % 3; j++) {
+            make_key(key, i);
+            float *count = ht_map_upsert(map, key, 0.0);
+            assert(count != NULL);
+            (*count)++;
+        }
+    }
+    assert(map->count == KEY_COUNT);
+    for (unsigned int i = 0; i < KEY_COUNT; i++) {
+        make_key(key, i);
+        assert(*ht_map_get(map, key) == (float)(i % 3 + 1));
+    }
+    printf("👍 ht_map_upsert napocital vyskyty\n");
+}
+
+/* to same pres ht_map_add a ht_map_increment, jedno vyhledani na vyskyt */
+void count_add(ht_map_t *map) {
+    char key[MAX_KEY_LEN];
+    for (unsigned int i = 0; i < KEY_COUNT; i++) {
+        make_key(key, i);
+        for (unsigned int j = 0; j <= i % 3; j++) {
+            assert(ht_map_increment(map, key) != NULL);
+        }
+        assert(*ht_map_add(map, key, 0.5) == (float)(i % 3 + 1) + 0.5f);
+    }
+    assert(map->count == KEY_COUNT);
+    for (unsigned int i = 0; i < KEY_COUNT; i++) {
+        make_key(key, i);
+        assert(*ht_map_get(map, key) == (float)(i % 3 + 1) + 0.5f);
+    }
+    printf("👍 ht_map_add napocital vyskyty\n");
+}
+
+/* ht_add a ht_increment nad tabulkou s pevnou velikosti */
+void table_add(void) {
+    ht_table_t table;
+    char key[MAX_KEY_LEN];
+    ht_init(&table);
+    for (unsigned int i = 0; i < 1000; i++) {
+        make_key(key, i % 100);
+        assert(ht_increment(&table, key) != NULL);
+    }
+    for (unsigned int i = 0; i < 100; i++) {
+        make_key(key, i);
+        assert(*ht_get(&table, key) == 10.0);
+        assert(*ht_add(&table, key, -10.0) == 0.0);
+    }
+    assert(*ht_add(&table, "novy", 2.5) == 2.5);
+    ht_delete_all(&table);
+    printf("👍 ht_add a ht_increment funguji i nad ht_table_t\n");
+}
+
+/* ht_search_batch a ht_get_batch nad tabulkou s pevnou velikosti */
+void table_batch(void) {
+    ht_table_t table;
+    char storage[2000][MAX_KEY_LEN];
+    char *keys[2000];
+    ht_item_t *items[2000];
+    float *values[2000];
+    ht_init(&table);
+    for (unsigned int i = 0; i < 2000; i++) {
+        make_key(storage[i], i);
+        keys[i] = storage[i];
+        if (i % 3 != 0) {
+            ht_insert(&table, keys[i], (float)i);
+        }
+    }
+    ht_search_batch(&table, keys, 2000, items);
+    ht_get_batch(&table, keys, 2000, values);
+    for (unsigned int i = 0; i < 2000; i++) {
+        assert(items[i] == ht_search(&table, keys[i]));
+        assert((values[i] == NULL) == (i % 3 == 0));
+        assert(values[i] == NULL || *values[i] == (float)i);
+    }
+    ht_delete_all(&table);
+    printf("👍 ht_search_batch nasel to same co ht_search\n");
+}
+
+/* filtr po smazani vetsiny klicu: po ht_map_bloom_rebuild se smazane
+ * klice vetsinou odmitnou uz filtrem a zbyle jsou porad videt */
+void bloom_rebuild(void) {
+    ht_map_t map;
+    char key[MAX_KEY_LEN];
+    assert(ht_map_init(&map));
+    assert(ht_map_bloom_enable(&map, KEY_COUNT));
+    for (unsigned int i = 0; i < KEY_COUNT; i++) {
+        make_key(key, i);
+        ht_map_insert(&map, key, (float)i);
+    }
+    for (unsigned int i = 0; i < KEY_COUNT; i++) {
+        if (i % 10 != 0) {
+            make_key(key, i);
+            ht_map_delete(&map, key);
+        }
+    }
+    assert(map.count == KEY_COUNT / 10);
+    assert(ht_map_bloom_rebuild(&map));
+    assert(map.bloom->capacity == KEY_COUNT);
+
+    size_t length;
+    unsigned int maybe = 0;
+    for (unsigned int i = 0; i < KEY_COUNT; i++) {
+        make_key(key, i);
+        unsigned int hash = ht_map_key_hash(&map, key, &length);
+        if (i % 10 == 0) {
+            assert(ht_bloom_may_contain(map.bloom, hash));
+            assert(*ht_map_get(&map, key) == (float)i);
+        } else {
+            maybe += ht_bloom_may_contain(map.bloom, hash);
+            assert(ht_map_get(&map, key) == NULL);
+        }
+    }
+    /* filtr je ted desetkrat vetsi nez treba, falesnych shod je malo */
+    assert(maybe < KEY_COUNT / 100);
+    ht_map_bloom_disable(&map);
+    assert(map.bloom == NULL);
+    assert(*ht_map_get(&map, "slovo0") == 0.0);
+    ht_map_destroy(&map);
+    printf("👍 filtr po smazani znovu sestaven, %u falesnych shod\n", maybe);
+}
+
+/* ht_map_*_n s klici jako useky bufferu bez nul */
+void map_length_keys(void) {
+    ht_map_t map;
+    char text[] = "alfa|beta|gama|alfa|alfabet";
+    assert(ht_map_init(&map));
+    for (char *p = text; *p != '\0';) {
+        size_t length = strcspn(p, "|");
+        ht_map_increment_n(&map, p, length);
+        p += length + (p[length] == '|');
+    }
+    assert(map.count == 4);
+    assert(*ht_map_get(&map, "alfa") == 2.0);
+    assert(*ht_map_get_n(&map, "alfabet", 4) == 2.0);
+    assert(*ht_map_get_n(&map, "alfabet", 7) == 1.0);
+    assert(ht_map_search_n(&map, "alfabet", 5) == NULL);
+    ht_map_insert_n(&map, "gamax", 4, 7.0);
+    assert(*ht_map_get(&map, "gama") == 7.0);
+    ht_map_delete_n(&map, "betax", 4);
+    assert(ht_map_get(&map, "beta") == NULL && map.count == 3);
+#if SIZE_MAX > UINT_MAX
+    /* delka pres UINT_MAX se neorizne na 4 a neshoduje se s "alfa" */
+    size_t huge = (size_t)UINT_MAX + 5;
+    assert(ht_map_search_n(&map, "alfa", huge) == NULL);
+    assert(ht_map_upsert_n(&map, "alfa", huge, 1.0) == NULL);
+    ht_map_delete_n(&map, "alfa", huge);
+    assert(map.count == 3 && *ht_map_get(&map, "alfa") == 2.0);
+#endif
+    ht_map_destroy(&map);
+    printf("👍 ht_map_*_n s klici bez nuly\n");
+}
+
+/* ujisti se ze v tabulce nic neni */
+void assert_empty(ht_map_t *map) {
+    assert(map->count == 0);
+    assert(map->old_buckets == NULL);
+    for (size_t i = 0; i < map->size; i++) {
+        assert(map->buckets[i] == NULL);
+    }
+}
+
+/* cela sada testu nad jednou tabulkou */
+void run_all(ht_map_t *map) {
+    assert_empty(map);
+    assert(ht_map_search(map, "nic") == NULL);
+
+    insert_all(map);
+    update_all(map);
+    delete_even(map);
+
+    ht_map_delete_all(map);
+    assert_empty(map);
+
+    count_upsert(map);
+    ht_map_delete_all(map);
+    assert_empty(map);
+
+    count_add(map);
+    ht_map_delete_all(map);
+    assert_empty(map);
+
+    /* po smazani vseho jde tabulka zase pouzit */
+    ht_map_insert(map, "znovu", 1.0);
+    assert(*ht_map_get(map, "znovu") == 1.0);
+
+    ht_map_destroy(map);
+}
+
+int main() {
+    ht_map_t map;
+
+    assert(ht_map_init(&map));
+    run_all(&map);
+
+    /* to same s prvky v arene */
+    assert(ht_map_init_arena(&map));
+    assert(map.arena != NULL);
+    run_all(&map);
+
+    /* to same s Bloomovym filtrem, ktery se behem plneni nekolikrat
+     * sestavi znovu pro vic klicu */
+    assert(ht_map_init(&map));
+    assert(ht_map_bloom_enable(&map, 1000));
+    run_all(&map);
+    bloom_rebuild();
+
+    /* to same s polem velikosti mocniny dvojky */
+    assert(ht_map_init_pow2(&map));
+    assert(map.size == 1u << HT_MAP_INIT_BITS);
+    run_all(&map);
+
+    table_add();
+    table_batch();
+    map_length_keys();
+    printf("👍 vsechny testy ht_map prosly\n");
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * testy delene tabulky ht_shard_t a jejiho paralelniho slucovani
+ *
+ * nekolik vlaken pocita vyskyty slov, kazde do sve tabulky, a vysledek
+ * po slouceni se porovna s pocitanim v jedne ht_map_t
+ */
+
+#include <assert.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "ht_shard.h"
+#include "test_words.h"
+
+#define WORKERS 4
+
+/* kolikrat se projde seznam slov */
+#define ROUNDS 3
+
+ht_shard_t shards[WORKERS];
+
+/* vlakno w pocita kazde slovo, jehoz index je delitelny w + 1 */
+void *count_worker(void *arg) {
+    unsigned int w = *(unsigned int *)arg;
+    for (unsigned int r = 0; r < ROUNDS; r++) {
+        for (unsigned int i = 0; i < word_count; i += w + 1) {
+            float *count = ht_shard_upsert(&shards[w], words[i], 0.0);
+            assert(count != NULL);
+            (*count)++;
+        }
+    }
+    return NULL;
+}
+
+/* scitani: vysledek musi sedet s jednovlaknovym pocitanim */
+void test_sum(unsigned int merge_threads) {
+    pthread_t threads[WORKERS];
+    unsigned int ids[WORKERS];
+    for (unsigned int w = 0; w < WORKERS; w++) {
+        assert(ht_shard_init(&shards[w]));
+        ids[w] = w;
+        assert(pthread_create(&threads[w], NULL, count_worker, &ids[w]) == 0);
+    }
+    for (unsigned int w = 0; w < WORKERS; w++) {
+        pthread_join(threads[w], NULL);
+    }
+
+    ht_map_t expected;
+    assert(ht_map_init(&expected));
+    for (unsigned int w = 0; w < WORKERS; w++) {
+        for (unsigned int r = 0; r < ROUNDS; r++) {
+            for (unsigned int i = 0; i < word_count; i += w + 1) {
+                (*ht_map_upsert(&expected, words[i], 0.0))++;
+            }
+        }
+    }
+
+    /* slouci se do prvni tabulky, ostatni se vyprazdni */
+    ht_shard_merge(&shards[0], shards, WORKERS, ht_shard_sum, merge_threads);
+    assert(ht_shard_count(&shards[0]) == expected.count);
+    for (unsigned int w = 1; w < WORKERS; w++) {
+        assert(ht_shard_count(&shards[w]) == 0);
+    }
+    for (unsigned int i = 0; i < word_count; i++) {
+        float *count = ht_shard_get(&shards[0], words[i]);
+        assert(count != NULL);
+        assert(*count == *ht_map_get(&expected, words[i]));
+    }
+    printf("👍 soucty po slouceni %u vlakny sedi (%zu slov)\n", merge_threads,
+           expected.count);
+
+    ht_map_destroy(&expected);
+    for (unsigned int w = 0; w < WORKERS; w++) {
+        ht_shard_destroy(&shards[w]);
+    }
+}
+
+/* nahrazovani: vyhraje posledni tabulka, ktera klic ma */
+void test_replace(void) {
+    ht_shard_t dest;
+    assert(ht_shard_init(&dest));
+    for (unsigned int w = 0; w < WORKERS; w++) {
+        assert(ht_shard_init(&shards[w]));
+        for (unsigned int i = 0; i < word_count; i += w + 1) {
+            ht_shard_insert(&shards[w], words[i], (float)w);
+        }
+    }
+    ht_shard_insert(&dest, "jen v cili", 42.0);
+
+    ht_shard_merge(&dest, shards, WORKERS, ht_shard_replace, WORKERS);
+    assert(*ht_shard_get(&dest, "jen v cili") == 42.0);
+    for (unsigned int i = 0; i < word_count; i++) {
+        unsigned int last = 0;
+        for (unsigned int w = 0; w < WORKERS; w++) {
+            if (i % (w + 1) == 0) {
+                last = w;
+            }
+        }
+        assert(*ht_shard_get(&dest, words[i]) == (float)last);
+    }
+    printf("👍 nahrazovani bere hodnotu z posledni tabulky\n");
+
+    ht_shard_delete(&dest, "jen v cili");
+    assert(ht_shard_search(&dest, "jen v cili") == NULL);
+    ht_shard_destroy(&dest);
+    for (unsigned int w = 0; w < WORKERS; w++) {
+        ht_shard_destroy(&shards[w]);
+    }
+}
+
+/* delka klice pres UINT_MAX se neorizne ani v _n, ani v ht_map_*_hashed */
+void test_long_key(void) {
+    ht_shard_t shard;
+    assert(ht_shard_init(&shard));
+    ht_shard_insert(&shard, "alfa", 1.0);
+#if SIZE_MAX > UINT_MAX
+    size_t huge = (size_t)UINT_MAX + 5;
+    assert(ht_shard_search_n(&shard, "alfa", huge) == NULL);
+    assert(ht_shard_upsert_n(&shard, "alfa", huge, 2.0) == NULL);
+    assert(ht_shard_add_n(&shard, "alfa", huge, 2.0) == NULL);
+    ht_shard_insert_n(&shard, "alfa", huge, 2.0);
+    assert(ht_shard_get_n(&shard, "alfa", huge) == NULL);
+    ht_shard_delete_n(&shard, "alfa", huge);
+    assert(ht_shard_count(&shard) == 1 && *ht_shard_get(&shard, "alfa") == 1.0);
+
+    /* hash spocitany pro 4 bajty, delka predana zvlast */
+    for (unsigned int i = 0; i < HT_SHARD_PARTS; i++) {
+        ht_map_t *part = &shard.parts[i];
+        unsigned int hash = ht_map_key_hash_n(part, "alfa", 4);
+        assert(ht_map_search_hashed(part, "alfa", huge, hash) == NULL);
+        assert(ht_map_upsert_hashed(part, "alfa", huge, hash, 2.0) == NULL);
+    }
+    assert(ht_shard_count(&shard) == 1 && *ht_shard_get(&shard, "alfa") == 1.0);
+#endif
+    ht_shard_destroy(&shard);
+    printf("👍 prilis dlouhy klic se odmitne\n");
+}
+
+int main() {
+    test_sum(1);
+    test_sum(WORKERS);
+    test_replace();
+    test_long_key();
+    printf("👍 vsechny testy ht_shard prosly\n");
+    return 0;
+}
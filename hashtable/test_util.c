@@ -63,9 +63,3 @@ void init_test_table(ht_table_t **table) {
     (**table)[i] = uninitialized_item;
   };
 }
-
-void ht_insert_many(ht_table_t *table, const ht_item_t items[], int count) {
-  for (int i = 0; i < count; i++) {
-    ht_insert(table, items[i].key, items[i].value);
-  }
-}
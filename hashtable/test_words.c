@@ -0,0 +1,1008 @@
+/* seznam 999 ruznych klicu z test_muj_2.c, sdileny testy a benchmarky */
+
+#include "test_words.h"
+
+const unsigned int words_start = __LINE__; char *words[] = {
+    "homeschooling",
+    "equivocally",
+    "Saratov's",
+    "apostleship's",
+    "Clint",
+    "lithuania",
+    "ticklish",
+    "befringes",
+    "incloser's",
+    "Milazzo",
+    "pretending",
+    "consortism",
+    "sterilities",
+    "riotry",
+    "Bipontine",
+    "curveballing",
+    "Oreo",
+    "Acrocarpi's",
+    "aeroembolism's",
+    "Maximilianus's",
+    "mouthing's",
+    "gramarye's",
+    "sevastopol",
+    "salsuginose",
+    "Francophobe's",
+    "relier's",
+    "underbarber",
+    "butterfly's",
+    "cornification",
+    "serviceman",
+    "britts",
+    "presuppositional",
+    "survivoress",
+    "Neoclassicisms",
+    "flatbottom",
+    "ancienter",
+    "pyotherapy",
+    "nontemptation",
+    "occipitally",
+    "quillet",
+    "Fascist",
+    "pretracing",
+    "parcellize",
+    "humanism",
+    "hydroextractor's",
+    "tanzib",
+    "sciaena",
+    "avenage",
+    "Antisi",
+    "Achaeus's",
+    "tagilite",
+    "ana",
+    "proteinuria",
+    "abampere's",
+    "berkelium",
+    "Ocaml",
+    "Cocceianism",
+    "olacad",
+    "raves",
+    "Cervulus's",
+    "spillages",
+    "Nenney",
+    "curmurrings",
+    "stereoscopists",
+    "Berycomorphi",
+    "anatomicopathologic",
+    "corrigenda's",
+    "lowlanders",
+    "Bahreini's",
+    "Jacksontown",
+    "folkmotes",
+    "infantility",
+    "overdesigned",
+    "beautying",
+    "pressureless",
+    "anatta's",
+    "eutaxitic",
+    "dunams",
+    "Yeung's",
+    "Ensenada",
+    "pouldered",
+    "persister",
+    "herden",
+    "provings",
+    "realtie",
+    "Monogynia's",
+    "optimalities",
+    "seaman's",
+    "pretermitting",
+    "caky",
+    "Faith's",
+    "Kumler",
+    "mousiness's",
+    "universeful",
+    "albertype",
+    "henotheist's",
+    "Aubry's",
+    "bodkin",
+    "unilocularity",
+    "Erythroxylum's",
+    "spilehole",
+    "sonneteer's",
+    "phytoplankter's",
+    "outsleep",
+    "nea",
+    "meh",
+    "Düsseldorf's",
+    "loudering",
+    "Rhizostomata",
+    "rollcollar's",
+    "unthinking",
+    "Africanist",
+    "bergfalls",
+    "Gault",
+    "ragbolt",
+    "Cerberi",
+    "suffrutescent",
+    "boughy",
+    "racemose",
+    "Bothwell",
+    "anodontia",
+    "defibrillation",
+    "ginhouses",
+    "martinetish",
+    "evonymus's",
+    "Assiniboin",
+    "puerpera",
+    "Helmand",
+    "Louisville",
+    "softer",
+    "heliculturalist",
+    "Arundel",
+    "Crocus",
+    "imperviableness",
+    "typhoons",
+    "aftertaste's",
+    "Tatarian",
+    "antirachitic's",
+    "spanopnea",
+    "norcamphane",
+    "vraisemblances",
+    "Nuculacea",
+    "ichthyosaurid",
+    "censuses",
+    "apomicts",
+    "microbars",
+    "instructible",
+    "microspherical",
+    "crapehanging",
+    "Marcionism",
+    "nonnihilistic",
+    "cotised",
+    "parataxes",
+    "contadino's",
+    "prestatistical",
+    "nettlewort",
+    "scrawly",
+    "ganched",
+    "ophthalmodynamometer",
+    "amontillados",
+    "lowne",
+    "Sinto's",
+    "Skagway",
+    "myxoenchondroma",
+    "blaeness",
+    "zihar",
+    "poephila",
+    "alcoate",
+    "boondocks",
+    "afoul",
+    "symptomizing",
+    "sagoins",
+    "unplaying",
+    "whales's",
+    "forfairn",
+    "frowier",
+    "Skaneateles",
+    "carrys",
+    "schorlous",
+    "photocatalysis",
+    "semidivine",
+    "broncho",
+    "Tecmessa's",
+    "rejuvenizing",
+    "perdus",
+    "coffinite",
+    "Polypifera's",
+    "irretentiveness",
+    "Marlie's",
+    "compendiary",
+    "disponee",
+    "achenia",
+    "drazels",
+    "sacheted",
+    "stethoscopist's",
+    "semitorpid",
+    "homopteran",
+    "stomatophorous",
+    "enslumber",
+    "halituses",
+    "sexological",
+    "unicyclist's",
+    "bellamoures",
+    "supergroup's",
+    "circuitousness's",
+    "talahib",
+    "triploids",
+    "crescentwise",
+    "Devonic",
+    "puncticulose",
+    "cleansings",
+    "aspersive",
+    "Madelaine's",
+    "harpoonlike",
+    "Eugen's",
+    "sufferable",
+    "athermancies",
+    "Jeeze's",
+    "gladrags",
+    "Hardunn",
+    "Roszak's",
+    "turpid",
+    "xylotile",
+    "Yuman",
+    "subducted",
+    "Lothario",
+    "satoris",
+    "unhumored",
+    "surculous",
+    "sanguineousness",
+    "bombo",
+    "talbotype",
+    "illiberalizes",
+    "historicized",
+    "barbicel's",
+    "marshiness",
+    "letterspaced",
+    "canto's",
+    "Ermey",
+    "epidermises",
+    "theologastric",
+    "disadvantaging",
+    "peckly",
+    "dodkin's",
+    "cyanophil",
+    "Littrow",
+    "Teutonomania's",
+    "physis",
+    "Amasa's",
+    "frutify",
+    "Ancyloceras",
+    "festooned",
+    "amyotrophia",
+    "caramba",
+    "dooles",
+    "Admiral",
+    "physicopsychical",
+    "hambones",
+    "scramjet's",
+    "cowfeeders",
+    "methoxychlor's",
+    "Lovett's",
+    "Atymnius",
+    "Listera",
+    "olé's",
+    "cukes",
+    "isorosindone",
+    "halfhourly",
+    "vapulating",
+    "Wendt",
+    "Tidioute",
+    "evigilation",
+    "undershorts",
+    "Cuzzart's",
+    "victrices",
+    "hetherward",
+    "Paludicella",
+    "bubblegum's",
+    "Colliers",
+    "unripplingly",
+    "unilateralism",
+    "Antone's",
+    "tunneries",
+    "Anomalon's",
+    "tabularly",
+    "Hants",
+    "templet",
+    "blanchimeter",
+    "microphagocyte",
+    "Naubinway's",
+    "unallusiveness",
+    "Enzed's",
+    "Alnascharism",
+    "fourpence's",
+    "toddlerhood's",
+    "superenergetically",
+    "debasednesses",
+    "Bagobo",
+    "Italomania's",
+    "dearticulation",
+    "nontheocratic",
+    "overslur",
+    "condolers",
+    "misbrands",
+    "Meltonian",
+    "Hedda's",
+    "pint",
+    "muskellunges",
+    "calpul",
+    "sporangiolum",
+    "insufflations",
+    "rabidities",
+    "Spense",
+    "corosif",
+    "mastodon's",
+    "Schmitz",
+    "swelltoad",
+    "ichthyodorulite",
+    "Gourdine",
+    "pliotron's",
+    "nonascendency",
+    "apopyle",
+    "obliquation",
+    "cynghanedd",
+    "prenticeships",
+    "Broaddus",
+    "noncumulatively",
+    "Lockean",
+    "fadingness",
+    "planography",
+    "attainers",
+    "lemminglike",
+    "Carrere",
+    "Joshia",
+    "overspinning",
+    "aphrasia",
+    "Kaffirs",
+    "khansamahs",
+    "nonadvertence",
+    "Aidoneus's",
+    "thingumabob",
+    "nonsubstantiveness",
+    "tralaticiary",
+    "solicities",
+    "buirdlier",
+    "recompile",
+    "Lillian",
+    "acetylacetone",
+    "Guesde",
+    "commonalty",
+    "poussies",
+    "rafales",
+    "Pipra's",
+    "subtilities",
+    "lasiurus",
+    "bobbling",
+    "Saadi",
+    "hydramine",
+    "Felicie",
+    "horn",
+    "discoplacental",
+    "outgive",
+    "unswathable",
+    "intoxicantly",
+    "Amintore",
+    "unrecalcitrant",
+    "valeur",
+    "pseudonational",
+    "acute's",
+    "moric",
+    "Lollardism",
+    "Damalas",
+    "drymarchon",
+    "formably",
+    "Tula",
+    "alphosis's",
+    "unavenued",
+    "phalangists",
+    "barroom's",
+    "quinquenerved",
+    "brechams",
+    "leafiest",
+    "Livistona's",
+    "bultell",
+    "powdered",
+    "archenemy's",
+    "sundog's",
+    "osteogenies",
+    "Profant",
+    "Katherin's",
+    "brails",
+    "Roath's",
+    "intracavitary",
+    "hachiman",
+    "sulphamate",
+    "limuloid's",
+    "scenewright",
+    "percivale",
+    "bathyplankton",
+    "Kinkaider's",
+    "bricole",
+    "nonreader's",
+    "clausular",
+    "Pangwe's",
+    "deploying",
+    "perissodactylous",
+    "mazaltov",
+    "otoconium",
+    "Agee's",
+    "Jewling's",
+    "Quinter's",
+    "prounionism",
+    "Jon's",
+    "stogeys",
+    "cantillates",
+    "Mpangwe",
+    "fisherfolk",
+    "luxation's",
+    "confliction",
+    "Dioscoreaceae",
+    "Glennon's",
+    "dereign",
+    "officerism",
+    "Kenilworth",
+    "outstaying",
+    "squiggle",
+    "Delaplane's",
+    "falconoid",
+    "polyandrious",
+    "stalactites",
+    "Kathlyn's",
+    "Warners",
+    "basined",
+    "Deluc",
+    "strombiform",
+    "Asklepios",
+    "provincial's",
+    "Atremata",
+    "ticktack's",
+    "vibratilities",
+    "circumhorizontal",
+    "overwash's",
+    "Freefone's",
+    "oversimplifies",
+    "dorsipinal",
+    "Sharp",
+    "hippiehood's",
+    "pentode's",
+    "quodlibet",
+    "misrendered",
+    "varella",
+    "envelope",
+    "Aurungzeb's",
+    "proctorship's",
+    "inseam's",
+    "Wykehamist",
+    "deribs",
+    "hematophyte",
+    "defervescing",
+    "Rhinegrave",
+    "fainted",
+    "schoolboy's",
+    "Sihasapa",
+    "comeuppance's",
+    "pachycephalic",
+    "Dorthy's",
+    "Squatinidae's",
+    "Fawnia's",
+    "archaizers",
+    "distorter",
+    "promoter's",
+    "Denair's",
+    "riverward",
+    "weans",
+    "flecking",
+    "pharyngopalatinus",
+    "rous",
+    "Republicanism's",
+    "Fars",
+    "mailing's",
+    "oxytoluene",
+    "undivulged",
+    "Suberitidae's",
+    "lackaday",
+    "Jetson's",
+    "slyboots's",
+    "Arenzville",
+    "rest's",
+    "brugh's",
+    "purveyance",
+    "unburly",
+    "dislock",
+    "houseman",
+    "malapportionment's",
+    "Tammie's",
+    "salmonellosis's",
+    "paramitome",
+    "desiderata",
+    "knuckling",
+    "invitatory's",
+    "analogous",
+    "ochlophobist",
+    "hoop",
+    "idiotical",
+    "entomostracan",
+    "Slater",
+    "Schifra",
+    "gamotropism",
+    "oscurrantist",
+    "Ermani",
+    "pendulously",
+    "stickabilities",
+    "balkanize",
+    "Xenopus",
+    "hemichorea",
+    "mecca",
+    "unmissionized",
+    "indowing",
+    "dethroning",
+    "reburying",
+    "Reeve's",
+    "Mbandaka's",
+    "inoculum",
+    "recuses",
+    "shagpate",
+    "alnagers",
+    "nigrosin's",
+    "abature",
+    "ascogonidia",
+    "peletre",
+    "stuffing",
+    "rouleau's",
+    "eyrie",
+    "ixodic",
+    "thiobacteriaceae",
+    "ephydriad",
+    "trebles",
+    "kinglessness",
+    "Caractacus",
+    "preslices",
+    "kiosks",
+    "Queensland",
+    "matchup's",
+    "isospore",
+    "saxitoxin",
+    "backboard's",
+    "dredge's",
+    "Hatcher's",
+    "assumptiveness",
+    "swastica's",
+    "discredit's",
+    "Masefield",
+    "fiendlier",
+    "lacinula",
+    "anticlimax",
+    "oversized",
+    "drusy",
+    "octavo's",
+    "hydride",
+    "decamerous",
+    "metalized",
+    "histochemists",
+    "fruitbearing",
+    "Nautiloidea",
+    "hypophysectomies",
+    "superinscription",
+    "eludible",
+    "Ionian's",
+    "MiG",
+    "adorers",
+    "fourteenfold",
+    "heterokaryons",
+    "cestraciont",
+    "unpreluded",
+    "enceintes",
+    "subdenomination",
+    "alleluia",
+    "distritbuting",
+    "Medusaean",
+    "Jessieville's",
+    "brune",
+    "azolitmin",
+    "dhyal",
+    "speeches",
+    "Anastatica",
+    "philocalic",
+    "paleocortical",
+    "Trafalgar",
+    "anabaena",
+    "tuberculars",
+    "motivate",
+    "burdened",
+    "Khosa",
+    "plowshoe",
+    "puls",
+    "wyvern",
+    "cosmetized",
+    "polypore's",
+    "androgonium",
+    "stathenries",
+    "Eustasius",
+    "Saccobranchus",
+    "bc",
+    "carbazole's",
+    "Teutomania",
+    "brominize",
+    "morro's",
+    "rhynchocoele",
+    "predispose",
+    "cushewbird",
+    "arrayal's",
+    "krabs",
+    "boxen",
+    "Birchist's",
+    "nonstructural",
+    "subplacentas",
+    "glitchy",
+    "neoblast's",
+    "perceptually",
+    "unroped",
+    "collusion's",
+    "metropathia",
+    "devalue",
+    "Maxy's",
+    "spheroidism",
+    "Diels",
+    "joual",
+    "elect",
+    "cycas",
+    "mockadoes",
+    "entries",
+    "syncing",
+    "sterlingness's",
+    "almuce",
+    "sanitaria",
+    "suba's",
+    "supernecessity",
+    "overwound",
+    "critism",
+    "erythropoietins",
+    "potentiator",
+    "micromillimeter's",
+    "supportability's",
+    "hyaloplasmic",
+    "Cneorum's",
+    "chaining",
+    "pedestalling's",
+    "Helvidian",
+    "antiracist's",
+    "peritonaeums",
+    "manganous",
+    "densate",
+    "Bagirmi",
+    "counterwoman's",
+    "heathery",
+    "copalcocote",
+    "houhere",
+    "Bovidae",
+    "Faeroese",
+    "entomologic",
+    "heniquen's",
+    "diapensiaceous",
+    "molochs",
+    "jomo",
+    "politico's",
+    "uncourageousness",
+    "MariaDB's",
+    "distilling",
+    "nondancers",
+    "recalibrations",
+    "eucalyptus",
+    "banking's",
+    "reicing",
+    "forletting",
+    "abattoir's",
+    "anaphoral",
+    "Valdivia's",
+    "ellipsoids",
+    "cathedrallike",
+    "Paulician's",
+    "Jhuria",
+    "supraterrestrial",
+    "gerfalcons",
+    "houppelande",
+    "laminarin",
+    "equivokes",
+    "apocynum",
+    "symbolographies",
+    "mislodged",
+    "ophiolite",
+    "birt",
+    "reinfuses",
+    "Maurise's",
+    "Elyot",
+    "gods",
+    "Malplaquet's",
+    "pickpocketism",
+    "Duplicidentata's",
+    "Arsinoitherium's",
+    "grooliest",
+    "Yurev",
+    "bloodthirstiest",
+    "Hildagard's",
+    "jurisprudentially",
+    "puncturers",
+    "steroid",
+    "blowball",
+    "superheterodynes",
+    "tainture",
+    "Hylobates's",
+    "Samau's",
+    "dynast",
+    "parkour",
+    "dourade",
+    "bedizenments",
+    "extraphysical",
+    "oranges",
+    "tutted",
+    "airbills",
+    "Petronille's",
+    "Azorean's",
+    "chuckrum",
+    "boozier",
+    "anthropolatries",
+    "encratism",
+    "docker",
+    "possemen",
+    "heypen",
+    "hanch",
+    "latheriest",
+    "Enhydrinae",
+    "sifting's",
+    "coitions",
+    "bosporus",
+    "setterwort",
+    "furiosa",
+    "general's",
+    "Araneae",
+    "soopings",
+    "migrant",
+    "trepanner",
+    "detestablenesses",
+    "zinckenite's",
+    "yferre",
+    "sabermetrician",
+    "capos",
+    "propend",
+    "epilate",
+    "Sagaponack",
+    "Attidae",
+    "Ochrana's",
+    "Alectryon",
+    "confoundednesses",
+    "stubbliest",
+    "vaccinator",
+    "dissogony",
+    "Methodist",
+    "irreligiousnesses",
+    "intramolecular",
+    "Typhon's",
+    "Plutonism",
+    "discumber",
+    "butyrolactone",
+    "magazinelet",
+    "formalness",
+    "somites",
+    "emplonged",
+    "Hagen's",
+    "poem's",
+    "warrands",
+    "Maely's",
+    "aired",
+    "accomplish",
+    "disintricated",
+    "draggletailedness",
+    "stoneite",
+    "weeble",
+    "zoobiotic",
+    "sighting",
+    "swelchie",
+    "preheater's",
+    "vestiture",
+    "snowfleck",
+    "Kidder's",
+    "nondebilitative",
+    "gallature",
+    "kyushu",
+    "Meloidae's",
+    "fatbirds",
+    "antiaphrodisiac",
+    "dateableness",
+    "vaccination's",
+    "Mendenhall",
+    "kasher",
+    "Aria's",
+    "unresounded",
+    "preexhaustion",
+    "actinouraniums",
+    "Wahoo's",
+    "satyr's",
+    "Unni",
+    "Pectinibranchia's",
+    "hematozymotic",
+    "Epizoa",
+    "Loretto's",
+    "acheer",
+    "exteroceptive",
+    "lorries",
+    "incitable",
+    "copingstones",
+    "sorehon",
+    "moosa",
+    "Hydrometridae's",
+    "phacolite",
+    "sollars",
+    "Cuphea",
+    "Chabichou",
+    "striature",
+    "Bellaghy",
+    "gastroduodenoscopy",
+    "detonator's",
+    "Blodenwedd",
+    "discommendations",
+    "unfixities",
+    "centralistic",
+    "Shuma",
+    "slowhound",
+    "Triarthrus's",
+    "noctambulant",
+    "expropriable",
+    "xanthomas",
+    "underwriting",
+    "congresswoman",
+    "proamendment",
+    "desensitization's",
+    "totalitizer",
+    "Gersham's",
+    "chillier",
+    "cyprinid's",
+    "overcuriousness",
+    "dikelocephalid",
+    "alehoof",
+    "Felecia's",
+    "filling",
+    "augmentive",
+    "ingates",
+    "fantasticality",
+    "mallow's",
+    "nimrod",
+    "Tympanuchus's",
+    "innovative",
+    "fibster's",
+    "detoured",
+    "caltrop",
+    "rehash",
+    "strawless's",
+    "bratchet's",
+    "douches",
+    "underbite",
+    "gangsterism",
+    "Benzedrine",
+    "chambranle's",
+    "huntaway",
+    "chandrakanta",
+    "selamlik's",
+    "Sperling's",
+    "inflictions",
+    "Kline",
+    "protanomal",
+    "foretime",
+    "Rickman's",
+    "quoitlike",
+    "acidheads",
+    "unplough",
+    "pleuropneumonic",
+    "logouts",
+    "squatters",
+    "engrege",
+    "tetraglottic",
+    "Toltecs",
+    "cressy",
+    "hydrocrack",
+    "Wyethia's",
+    "scribacious",
+    "fingerhole",
+    "antennas",
+    "Aplodontia's",
+    "time's",
+    "Socratist's",
+    "Germanizing",
+    "abbasid",
+    "ritualistically",
+    "Cedarville's",
+    "Iberes's",
+    "shorls",
+    "muckers",
+    "Monsarrat",
+    "MGeolE's",
+    "tsesarewiches",
+    "monoeciousness",
+    "longspur",
+    "potamophilous",
+    "antirape",
+    "pseudotuberculosis's",
+    "Cruft",
+    "haikun",
+    "alambique",
+    "una",
+    "uglis",
+    "Scottice's",
+    "Rotal",
+    "ninhydrin",
+    "renationalize",
+    "yeasayers",
+    "unfolder's",
+    "cairn's",
+    "unspellable",
+    "cymbalos",
+    "Fittonia",
+    "pathophysiologies",
+    "snapps",
+    "dipleurule",
+    "perfidious",
+    "soldierdom",
+    "suspensory's",
+    "rusticities",
+    "conjunctivenesses",
+    "glissader",
+    "semialcoholic",
+    "Paddy",
+    "oppugner's",
+    "Chaco",
+    "Batesville's",
+    "preferential",
+    "brome's",
+    "Seconal's",
+    "Memling",
+    "sternoscapular",
+    "venenose",
+    "postencephalon",
+    "Brachyurus",
+    "strumming",
+    "attagen",
+    "blabbermouth's",
+    "mucorales",
+    "affections",
+    "nephroparalysis",
+    "unreverential",
+    "bowmaker",
+    "Collie's",
+    "geophilus",
+    "unvoluptuous",
+    "Mauri",
+    "storming",
+    "unluckful",
+    "solstitially",
+    "beni",
+    "wippen's",
+    "incumbition",
+    "vulpicidism",
+    "incisiform",
+    "hyperin",
+    "dysacousia",
+    "motiest",
+    "syr",
+    "tawsy",
+    "Henleigh's",
+    "gallinaceon's",
+    "perennibranch",
+    "longness's",
+    "ataxiameter",
+    "displodes",
+    "igniferousness",
+    "misbelieves",
+    "Sybarite's",
+    "kilnman",
+    "renewednesses",
+    "egards",
+    "magdalene",
+    "Gygaea's",
+    "telerecord",
+    "padle",
+    "Preminger's",
+    "conspue",
+    "undershored",
+    "nones",
+    "octodecimo's",
+    "subastral",
+    "Fremantle",
+    "recoagulate",
+    "excussion",
+    "minuscule's",
+    "hicket",
+    "pseudoaesthetic",
+    "thermatologic",
+    "Acanthophis",
+    "surds",
+    "optimalisation's",
+    "serratirostral",
+    "nepotism"
+}; const unsigned int words_end = __LINE__;
+
+const unsigned int word_count = 999;
@@ -0,0 +1,8 @@
+#ifndef IAL_HASHTABLE_TEST_WORDS_H
+#define IAL_HASHTABLE_TEST_WORDS_H
+
+/* pole ruznych klicu pro testy a benchmarky (viz test_words.c) */
+extern char *words[];
+extern const unsigned int word_count;
+
+#endif